@@ -0,0 +1,306 @@
+#include <benchmark/benchmark.h>
+#include "cubing/CubeState.h"
+#include "cubing/IterativeScramble.h"
+#include "cubing/MosaicDefs.h"
+#include "cubing/MovesVector.h"
+#include "cubing/ScrambleProcessing.h"
+#include <filesystem>
+#include <random>
+
+using namespace cubing;
+
+static constexpr size_t NUM_ALGS = 1024; // inputs are cycled through, so that a benchmark doesn't run on a single alg
+static constexpr size_t ALG_SIZE = 20;
+
+/// @returns NUM_ALGS canonicalized random algs, same ones on every run
+template<QtmMoveSetSize qtmMoveSetSize>
+static const std::vector<MovesVector<qtmMoveSetSize>>& random_algs() {
+    static const auto algs = [] {
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> random_move(0, qtmMoveSetSize * 3 - 1); // char types aren't valid IntTypes
+        std::vector<MovesVector<qtmMoveSetSize>> result(NUM_ALGS);
+        for (auto& alg : result) {
+            MovesVector<qtmMoveSetSize> moves;
+            for (size_t i = 0; i < ALG_SIZE; ++i) {
+                moves.push_back(uint8_t(random_move(rng)));
+            }
+            alg = moves.canonicalized();
+        }
+        return result;
+    }();
+    return algs;
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+static const std::vector<std::string>& random_alg_strings() {
+    static const auto strings = [] {
+        std::vector<std::string> result;
+        for (const auto& alg : random_algs<qtmMoveSetSize>()) {
+            result.push_back(alg.to_string());
+        }
+        return result;
+    }();
+    return strings;
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+static const std::vector<CubeState<qtmMoveSetSize>>& scrambled_cubes() {
+    static const auto cubes = [] {
+        std::vector<CubeState<qtmMoveSetSize>> result(NUM_ALGS);
+        for (size_t i = 0; i < NUM_ALGS; ++i) {
+            result[i].applyScramble(random_algs<qtmMoveSetSize>()[i]);
+        }
+        return result;
+    }();
+    return cubes;
+}
+
+static size_t total_size(const std::vector<std::string>& strings) {
+    size_t size = 0;
+    for (const auto& s : strings) {
+        size += s.size();
+    }
+    return size;
+}
+
+/* scrambling */
+
+template<QtmMoveSetSize qtmMoveSetSize>
+static void BM_ApplyScrambleMove(benchmark::State& state) {
+    CubeState<qtmMoveSetSize> cube;
+    uint8_t move = 0;
+    for (auto _ : state) {
+        cube.applyScrambleMove(move);
+        move = (move + 7) % (qtmMoveSetSize * 3);
+        benchmark::DoNotOptimize(cube);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+static void BM_ApplyScrambleMovesVector(benchmark::State& state) {
+    const auto& algs = random_algs<qtmMoveSetSize>();
+    size_t i = 0, num_moves = 0;
+    for (auto _ : state) {
+        CubeState<qtmMoveSetSize> cube;
+        cube.applyScramble(algs[i]);
+        benchmark::DoNotOptimize(cube);
+        num_moves += algs[i].size();
+        i = (i + 1) % algs.size();
+    }
+    state.SetItemsProcessed(num_moves);
+    state.counters["algs"] = benchmark::Counter(state.iterations(), benchmark::Counter::kIsRate);
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+static const std::vector<CubeState<qtmMoveSetSize>>& compiled_algs() {
+    static const auto permutations = [] {
+        std::vector<CubeState<qtmMoveSetSize>> result;
+        for (const auto& alg : random_algs<qtmMoveSetSize>()) {
+            result.push_back(CubeState<qtmMoveSetSize>::compileAlgorithm(alg));
+        }
+        return result;
+    }();
+    return permutations;
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+static void BM_ApplyPermutation(benchmark::State& state) {
+    const auto& permutations = compiled_algs<qtmMoveSetSize>();
+    size_t i = 0;
+    for (auto _ : state) {
+        CubeState<qtmMoveSetSize> cube;
+        cube.applyPermutation(permutations[i]);
+        benchmark::DoNotOptimize(cube);
+        i = (i + 1) % permutations.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/// state of the inverse alg straight from the compiled alg
+template<QtmMoveSetSize qtmMoveSetSize>
+static void BM_ApplyInversePermutation(benchmark::State& state) {
+    const auto& permutations = compiled_algs<qtmMoveSetSize>();
+    size_t i = 0;
+    for (auto _ : state) {
+        CubeState<qtmMoveSetSize> cube;
+        cube.applyInversePermutation(permutations[i]);
+        benchmark::DoNotOptimize(cube);
+        i = (i + 1) % permutations.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+static void BM_ApplyScrambleString(benchmark::State& state) {
+    const auto& algs = random_algs<qtmMoveSetSize>();
+    const auto& strings = random_alg_strings<qtmMoveSetSize>();
+    size_t i = 0, num_moves = 0, num_bytes = 0;
+    for (auto _ : state) {
+        CubeState<qtmMoveSetSize> cube;
+        cube.applyScramble(strings[i]);
+        benchmark::DoNotOptimize(cube);
+        num_moves += algs[i].size();
+        num_bytes += strings[i].size();
+        i = (i + 1) % strings.size();
+    }
+    state.SetItemsProcessed(num_moves);
+    state.SetBytesProcessed(num_bytes);
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+static void BM_IterativeScrambleIncrement(benchmark::State& state) {
+    // start at 4 moves, where skipping of parallel moves kicks in
+    auto scramble = IterativeScramble<qtmMoveSetSize>::from_moves(MovesVector<qtmMoveSetSize>::from_string(
+        std::string(CubeTraits<qtmMoveSetSize>::qtmMoves.substr(0, 1)) + " U R U"));
+    for (auto _ : state) {
+        ++scramble;
+        benchmark::DoNotOptimize(scramble);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/* cube state queries */
+
+template<QtmMoveSetSize qtmMoveSetSize>
+static void BM_FrontSideStickers(benchmark::State& state) {
+    const auto& cubes = scrambled_cubes<qtmMoveSetSize>();
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cubes[i].frontSideStickers());
+        i = (i + 1) % cubes.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * NUM_STICKERS_ON_ONE_SIDE);
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+static void BM_FrontAndBackSidesHaveSamePattern(benchmark::State& state) {
+    const auto& cubes = scrambled_cubes<qtmMoveSetSize>();
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cubes[i].doFrontAndBackSidesHaveSamePatternWithOppositeColors());
+        i = (i + 1) % cubes.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/* maps */
+
+template<QtmMoveSetSize qtmMoveSetSize>
+static void BM_InsertIfMoreConvenient(benchmark::State& state) {
+    const auto& algs = random_algs<qtmMoveSetSize>();
+    const auto& cubes = scrambled_cubes<qtmMoveSetSize>();
+    std::vector<std::string> patterns;
+    for (const auto& cube : cubes) {
+        patterns.push_back(cube.frontSideStickers());
+    }
+    PatternToAlgAndConvenienceMap map;
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(map.insert_if_more_convenient(patterns[i], algs[i]));
+        i = (i + 1) % algs.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+static PatternToAlgMap random_pattern_to_alg_map() {
+    PatternToAlgMap map;
+    const auto& cubes = scrambled_cubes<qtmMoveSetSize>();
+    const auto& strings = random_alg_strings<qtmMoveSetSize>();
+    for (size_t i = 0; i < NUM_ALGS; ++i) {
+        map.insert_if_preferred(cubes[i].frontSideStickers(), strings[i]);
+    }
+    return map;
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+static std::string temp_alg_file_path(const char* name) {
+    return (std::filesystem::temp_directory_path() / (std::string(name) + std::to_string(qtmMoveSetSize)
+                                                      + std::string(ALGS_FILE_NAME))).string();
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+static void BM_SaveToFile(benchmark::State& state) {
+    const auto map = random_pattern_to_alg_map<qtmMoveSetSize>();
+    const auto path = temp_alg_file_path<qtmMoveSetSize>("cubing_benchmark_save_");
+    for (auto _ : state) {
+        if (!map.save_to_file(path)) {
+            state.SkipWithError("failed to save algs");
+            return;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * map.size());
+    state.SetBytesProcessed(state.iterations() * std::filesystem::file_size(path));
+    std::filesystem::remove(path);
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+static void BM_LoadFromFile(benchmark::State& state) {
+    const auto path = temp_alg_file_path<qtmMoveSetSize>("cubing_benchmark_load_");
+    if (!random_pattern_to_alg_map<qtmMoveSetSize>().save_to_file(path)) {
+        state.SkipWithError("failed to save algs");
+        return;
+    }
+    size_t num_algs = 0;
+    for (auto _ : state) {
+        const auto map = PatternToAlgMap::load_from_file(path);
+        num_algs += map.size();
+        benchmark::DoNotOptimize(map);
+    }
+    state.SetItemsProcessed(num_algs);
+    state.SetBytesProcessed(state.iterations() * std::filesystem::file_size(path));
+    std::filesystem::remove(path);
+}
+
+/* string transforms */
+
+template<QtmMoveSetSize qtmMoveSetSize, std::string (*transform)(const std::string&)>
+static void BM_StringTransform(benchmark::State& state) {
+    const auto& strings = random_alg_strings<qtmMoveSetSize>();
+    for (auto _ : state) {
+        for (const auto& alg : strings) {
+            benchmark::DoNotOptimize(transform(alg));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * strings.size());
+    state.SetBytesProcessed(state.iterations() * total_size(strings));
+}
+
+static std::string normalize_alg(const std::string& alg) {return normalize(alg);}
+
+#define CUBING_BENCHMARK_ALL_MOVE_SETS(func) \
+    BENCHMARK_TEMPLATE(func, sides333); \
+    BENCHMARK_TEMPLATE(func, sidesAndMid333); \
+    BENCHMARK_TEMPLATE(func, allMoves555)
+
+CUBING_BENCHMARK_ALL_MOVE_SETS(BM_ApplyScrambleMove);
+CUBING_BENCHMARK_ALL_MOVE_SETS(BM_ApplyScrambleMovesVector);
+CUBING_BENCHMARK_ALL_MOVE_SETS(BM_ApplyScrambleString);
+CUBING_BENCHMARK_ALL_MOVE_SETS(BM_ApplyPermutation);
+CUBING_BENCHMARK_ALL_MOVE_SETS(BM_ApplyInversePermutation);
+CUBING_BENCHMARK_ALL_MOVE_SETS(BM_IterativeScrambleIncrement);
+CUBING_BENCHMARK_ALL_MOVE_SETS(BM_FrontSideStickers);
+CUBING_BENCHMARK_ALL_MOVE_SETS(BM_FrontAndBackSidesHaveSamePattern);
+CUBING_BENCHMARK_ALL_MOVE_SETS(BM_InsertIfMoreConvenient);
+CUBING_BENCHMARK_ALL_MOVE_SETS(BM_SaveToFile);
+CUBING_BENCHMARK_ALL_MOVE_SETS(BM_LoadFromFile);
+
+#define CUBING_BENCHMARK_STRING_TRANSFORM(move_set, transform) \
+    BENCHMARK_TEMPLATE(BM_StringTransform, move_set, transform)->Name("BM_" #transform "<" #move_set ">")
+
+CUBING_BENCHMARK_STRING_TRANSFORM(sides333, invertScramble);
+CUBING_BENCHMARK_STRING_TRANSFORM(sidesAndMid333, invertScramble);
+CUBING_BENCHMARK_STRING_TRANSFORM(allMoves555, invertScramble);
+// string mirrors only know side moves
+CUBING_BENCHMARK_STRING_TRANSFORM(sides333, left2right);
+CUBING_BENCHMARK_STRING_TRANSFORM(sides333, front2back);
+CUBING_BENCHMARK_STRING_TRANSFORM(sides333, normalize_alg);
+CUBING_BENCHMARK_STRING_TRANSFORM(sidesAndMid333, normalize_alg);
+CUBING_BENCHMARK_STRING_TRANSFORM(allMoves555, normalize_alg);
+// tearing apart and gluing only applies to 333 algs
+CUBING_BENCHMARK_STRING_TRANSFORM(sides333, scrambleTearApart333);
+CUBING_BENCHMARK_STRING_TRANSFORM(sidesAndMid333, scrambleTearApart333);
+CUBING_BENCHMARK_STRING_TRANSFORM(sides333, scrambleGlueMoves333);
+CUBING_BENCHMARK_STRING_TRANSFORM(sidesAndMid333, scrambleGlueMoves333);
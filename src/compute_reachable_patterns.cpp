@@ -0,0 +1,29 @@
+#include <iostream>
+#include "cubing/MosaicDefs.h"
+#include "cubing/ReachablePatterns.h"
+#include <fmt/format.h>
+#include <filesystem>
+
+using namespace cubing;
+
+/// Computes which 9-sticker front patterns have a state with the same pattern in opposite colors on the back, and saves
+/// them as a bitmap to the working dir. find_two_sided_mosaic_algs and two_sided_mosaic_augmentation load it from
+/// there to report coverage of reachable patterns and to stop once all of them are found.
+int main(int argc, char** argv) {
+    if (argc != 2 || !std::filesystem::is_directory(argv[1])) {
+        std::cerr << "usage: " << argv[0] << " /path/to/working_dir" << std::endl;
+        exit(-1);
+    }
+    const auto reachable = reachable_two_sided_mosaic_patterns();
+    std::cout << fmt::format("{} of {} patterns are reachable", reachable.count(), NUM_PATTERNS) << std::endl;
+    for (const char center : std::string_view("WGROYB")) {
+        std::cout << fmt::format("  center {}: {}", center, reachable.with_center(center).count()) << std::endl;
+    }
+    const auto path = fmt::format("{}/{}", argv[1], REACHABLE_PATTERNS_FILE_NAME);
+    if (!reachable.save_to_file(path)) {
+        std::cerr << "Failed to save reachable patterns to " << path << std::endl;
+        exit(-1);
+    }
+    std::cout << "Saved to " << path << std::endl;
+    return 0;
+}
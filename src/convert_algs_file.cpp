@@ -0,0 +1,30 @@
+#include <iostream>
+#include "cubing/MosaicDefs.h"
+#include "cubing/CompressedAlgFile.h"
+#include <fmt/format.h>
+
+using namespace cubing;
+
+/*
+ * Converts algs file between text ("pattern \t alg" lines) and compressed formats. Output format is picked by the
+ * output file extension (.algz => compressed), input format is detected automatically.
+ * */
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "usage: " << argv[0] << " /path/to/input_algs /path/to/output_algs[" << COMPRESSED_ALGS_FILE_EXTENSION
+                  << "]" << std::endl;
+        exit(-1);
+    }
+    const auto map = PatternToAlgMap::load_from_file(argv[1]);
+    if (map.empty()) {
+        std::cerr << "No algs found in " << argv[1] << '\n';
+        return -1;
+    }
+    if (!map.save_to_file(argv[2])) {
+        std::cerr << "Failed to save algs to " << argv[2] << '\n';
+        return -1;
+    }
+    std::cout << "Converted " << map.size() << " algs to " << argv[2] << '\n';
+    return 0;
+}
@@ -0,0 +1,48 @@
+#include <iostream>
+#include "cubing/CubingDefs.h"
+#include "cubing/DifferentialTesting.h"
+#include <fmt/format.h>
+
+using namespace cubing;
+
+/// @returns number of engines that mismatch the reference
+template<QtmMoveSetSize qtmMoveSetSize>
+static size_t run_for_move_set(const DifferentialTestOptions& options) {
+    const DifferentialTester<qtmMoveSetSize> tester(DifferentialTester<qtmMoveSetSize>::builtin_engines());
+    std::cout << qtmMoveSetSize << ": " << options.num_sequences << " sequences of up to " << options.max_moves
+              << " moves, seed " << options.seed << std::endl;
+    size_t num_failed_engines = 0;
+    for (const auto& report : tester.run(options)) {
+        std::cout << fmt::format("  {:<20} {:>8.2f}M moves/s  x{:<6.2f} {:>6} mosaics  ", report.name,
+                                 report.moves_per_second / 1e6, report.speedup, report.num_mosaics);
+        if (report.num_mismatches == 0) {
+            std::cout << "OK" << std::endl;
+            continue;
+        }
+        ++num_failed_engines;
+        std::cout << report.num_mismatches << " MISMATCHES, minimized: <" << report.counterexample << "> "
+                  << report.mismatch << std::endl;
+    }
+    return num_failed_engines;
+}
+
+int main(int argc, char** argv) {
+    if (argc > 4) {
+        std::cerr << "usage: " << argv[0] << " [num_sequences] [max_moves] [seed]" << std::endl;
+        exit(-1);
+    }
+    DifferentialTestOptions options;
+    if (argc > 1) {
+        options.num_sequences = std::stoul(argv[1]);
+    }
+    if (argc > 2) {
+        options.max_moves = std::stoul(argv[2]);
+    }
+    if (argc > 3) {
+        options.seed = std::stoull(argv[3]);
+    }
+    size_t num_failed_engines = run_for_move_set<sides333>(options);
+    num_failed_engines += run_for_move_set<sidesAndMid333>(options);
+    num_failed_engines += run_for_move_set<allMoves555>(options);
+    return num_failed_engines == 0 ? 0 : 1;
+}
@@ -0,0 +1,342 @@
+#include "CompressedAlgFile.h"
+#include "MosaicDefs.h"
+#include <algorithm>
+#include <array>
+#include <fmt/format.h>
+
+namespace cubing {
+
+static constexpr std::string_view kMagic = "ALGZ";
+static constexpr uint8_t kVersion = 1;
+static constexpr std::string_view kColors = "WGROYB";
+static constexpr uint32_t kNumPatterns = 6 * 6 * 6 * 6 * 6 * 6 * 6 * 6 * 6;
+static constexpr size_t kFooterSize = 8 + 4 + 4; // index_offset, num_blocks, magic
+
+// alg tokens: 18 single letters + 6 wide moves, each of them cw/double/ccw => 72 one-byte codes
+static constexpr std::string_view kTokenLetters = "RUFLDBMESxyzrufldb";
+static constexpr std::string_view kWideLetters = "RUFLDB";
+static constexpr uint8_t kNumBaseTokens = kTokenLetters.size() + kWideLetters.size();
+
+uint32_t pattern_to_index(std::string_view pattern) {
+    if (pattern.size() != NUM_STICKERS_ON_ONE_SIDE) {
+        throw std::runtime_error(fmt::format("pattern_to_index: expected {} stickers, got <{}>",
+                                             NUM_STICKERS_ON_ONE_SIDE, pattern));
+    }
+    uint32_t index = 0;
+    for (char c : pattern) {
+        const auto digit = kColors.find(c);
+        if (digit == std::string_view::npos) {
+            throw std::runtime_error(fmt::format("pattern_to_index: unknown color in <{}>", pattern));
+        }
+        index = index * kColors.size() + digit;
+    }
+    return index;
+}
+
+std::string index_to_pattern(uint32_t index) {
+    std::string pattern(NUM_STICKERS_ON_ONE_SIDE, kColors[0]);
+    for (size_t i = NUM_STICKERS_ON_ONE_SIDE; i-- > 0; ) {
+        pattern[i] = kColors[index % kColors.size()];
+        index /= kColors.size();
+    }
+    return pattern;
+}
+
+/* byte helpers */
+static void put_varint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(char(uint8_t(value) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(char(value));
+}
+
+static uint64_t get_varint(const uint8_t*& p, const uint8_t* end) {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (p == end) {
+            throw std::runtime_error("compressed alg file: truncated varint");
+        }
+        const uint8_t byte = *p++;
+        value |= uint64_t(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return value;
+        }
+    }
+    throw std::runtime_error("compressed alg file: varint is too long");
+}
+
+static void put_fixed(std::string& out, uint64_t value, size_t num_bytes) {
+    for (size_t i = 0; i < num_bytes; ++i) {
+        out.push_back(char(uint8_t(value >> (8 * i))));
+    }
+}
+
+static uint64_t get_fixed(const uint8_t* p, size_t num_bytes) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < num_bytes; ++i) {
+        value |= uint64_t(p[i]) << (8 * i);
+    }
+    return value;
+}
+
+/* alg tokens */
+
+/// @returns token code of a single move like "Rw'" or "x2", or -1 if it's not a known token
+static int encode_move(std::string_view move) {
+    if (move.empty() || move.size() > 3) {
+        return -1;
+    }
+    size_t letter_index = kTokenLetters.find(move.front());
+    if (letter_index == std::string_view::npos) {
+        return -1;
+    }
+    move.remove_prefix(1);
+    if (!move.empty() && move.front() == 'w') {
+        letter_index = kWideLetters.find(kTokenLetters[letter_index]);
+        if (letter_index == std::string_view::npos) {
+            return -1;
+        }
+        letter_index += kTokenLetters.size();
+        move.remove_prefix(1);
+    }
+    if (move.size() > 1) {
+        return -1;
+    }
+    const int suffix = move.empty() ? 0 : (move.front() == '2' ? 1 : (move.front() == '\'' ? 2 : -1));
+    return suffix < 0 ? -1 : int(letter_index * 3 + suffix);
+}
+
+static void decode_move(uint8_t code, std::string& out) {
+    if (code >= kNumBaseTokens * 3) {
+        throw std::runtime_error(fmt::format("compressed alg file: invalid move code {}", code));
+    }
+    const uint8_t base = code / 3, suffix = code % 3;
+    if (base < kTokenLetters.size()) {
+        out.push_back(kTokenLetters[base]);
+    } else {
+        out.push_back(kWideLetters[base - kTokenLetters.size()]);
+        out.push_back('w');
+    }
+    if (suffix != 0) {
+        out.push_back(suffix == 1 ? '2' : '\'');
+    }
+}
+
+/// tokenizes @param alg into @param codes. @returns false if the alg isn't "move move move" with known moves
+static bool encode_alg(std::string_view alg, std::string& codes) {
+    codes.clear();
+    while (!alg.empty()) {
+        const auto space = alg.find(' ');
+        const auto move = alg.substr(0, space);
+        const int code = encode_move(move);
+        if (code < 0) {
+            return false;
+        }
+        codes.push_back(char(code));
+        if (space == std::string_view::npos) {
+            return true;
+        }
+        alg.remove_prefix(space + 1);
+        if (alg.empty()) {
+            return false; // trailing space wouldn't survive the round trip
+        }
+    }
+    return true;
+}
+
+static void put_alg(std::string& out, const std::string& alg, std::string& codes_buffer) {
+    if (encode_alg(alg, codes_buffer)) {
+        put_varint(out, uint64_t(codes_buffer.size()) << 1);
+        out += codes_buffer;
+    } else {
+        put_varint(out, (uint64_t(alg.size()) << 1) | 1);
+        out += alg;
+    }
+}
+
+static std::string get_alg(const uint8_t*& p, const uint8_t* end) {
+    const uint64_t header = get_varint(p, end);
+    const uint64_t length = header >> 1;
+    if (uint64_t(end - p) < length) {
+        throw std::runtime_error("compressed alg file: truncated alg");
+    }
+    std::string alg;
+    if (header & 1) {
+        alg.assign(reinterpret_cast<const char*>(p), length);
+    } else {
+        alg.reserve(length * 3);
+        for (uint64_t i = 0; i < length; ++i) {
+            if (i > 0) {
+                alg.push_back(' ');
+            }
+            decode_move(p[i], alg);
+        }
+    }
+    p += length;
+    return alg;
+}
+
+static void decode_block(const std::vector<uint8_t>& bytes,
+                         const std::function<void(const std::string&, const std::string&)>& callback) {
+    const uint8_t* p = bytes.data();
+    const uint8_t* end = p + bytes.size();
+    const uint64_t count = get_varint(p, end);
+    uint64_t pattern_index = 0;
+    for (uint64_t i = 0; i < count; ++i) {
+        pattern_index += get_varint(p, end);
+        if (pattern_index >= kNumPatterns) {
+            throw std::runtime_error("compressed alg file: pattern index out of range");
+        }
+        const auto alg = get_alg(p, end);
+        callback(index_to_pattern(uint32_t(pattern_index)), alg);
+    }
+}
+
+bool is_compressed_alg_file(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    char magic[kMagic.size()];
+    return file.read(magic, sizeof(magic)) && std::string_view(magic, sizeof(magic)) == kMagic;
+}
+
+bool save_compressed_alg_file(const std::string& path,
+                              const std::unordered_map<std::string, std::string>& pattern_to_alg,
+                              size_t entries_per_block) {
+    if (entries_per_block == 0) {
+        throw std::runtime_error("save_compressed_alg_file: entries_per_block must be positive");
+    }
+    std::vector<std::pair<uint32_t, const std::string*>> sorted;
+    sorted.reserve(pattern_to_alg.size());
+    for (const auto& [pattern, alg] : pattern_to_alg) {
+        sorted.emplace_back(pattern_to_index(pattern), &alg);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {return a.first < b.first;});
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::string buffer{kMagic};
+    buffer.push_back(char(kVersion));
+    uint64_t offset = 0;
+    std::string index, codes_buffer;
+    uint32_t num_blocks = 0;
+    for (size_t block_start = 0; block_start < sorted.size(); block_start += entries_per_block) {
+        const size_t block_end = std::min(sorted.size(), block_start + entries_per_block);
+        put_fixed(index, offset + buffer.size(), 8);
+        put_fixed(index, sorted[block_start].first, 4);
+        put_fixed(index, block_end - block_start, 4);
+        ++num_blocks;
+
+        put_varint(buffer, block_end - block_start);
+        uint32_t previous = 0;
+        for (size_t i = block_start; i < block_end; ++i) {
+            put_varint(buffer, sorted[i].first - previous);
+            previous = sorted[i].first;
+            put_alg(buffer, *sorted[i].second, codes_buffer);
+        }
+        if (buffer.size() > (1 << 20)) {
+            file.write(buffer.data(), std::streamsize(buffer.size()));
+            offset += buffer.size();
+            buffer.clear();
+        }
+    }
+    const uint64_t index_offset = offset + buffer.size();
+    buffer += index;
+    put_fixed(buffer, index_offset, 8);
+    put_fixed(buffer, num_blocks, 4);
+    buffer += kMagic;
+    file.write(buffer.data(), std::streamsize(buffer.size()));
+    file.close();
+    return file.good();
+}
+
+std::unordered_map<std::string, std::string> load_compressed_alg_file(const std::string& path) {
+    CompressedAlgFileReader reader(path);
+    std::unordered_map<std::string, std::string> result;
+    result.reserve(reader.size());
+    for (size_t i = 0; i < reader.num_blocks(); ++i) {
+        reader.for_each_in_block(i, [&result](const std::string& pattern, const std::string& alg) {
+            result.insert({pattern, alg});
+        });
+    }
+    return result;
+}
+
+CompressedAlgFileReader::CompressedAlgFileReader(const std::string& path) : file_(path, std::ios::binary) {
+    if (!file_.is_open()) {
+        throw std::runtime_error(fmt::format("Failed to open the file {}", path));
+    }
+    std::array<uint8_t, kMagic.size() + 1> header{};
+    file_.seekg(0, std::ios::end);
+    const auto file_size = uint64_t(file_.tellg());
+    file_.seekg(0);
+    if (file_size < header.size() + kFooterSize || !file_.read(reinterpret_cast<char*>(header.data()), header.size())
+        || std::string_view(reinterpret_cast<const char*>(header.data()), kMagic.size()) != kMagic) {
+        throw std::runtime_error(fmt::format("{} is not a compressed alg file", path));
+    }
+    if (header.back() != kVersion) {
+        throw std::runtime_error(fmt::format("{}: unsupported compressed alg file version {}", path, header.back()));
+    }
+
+    std::array<uint8_t, kFooterSize> footer{};
+    file_.seekg(std::streamoff(file_size - kFooterSize));
+    file_.read(reinterpret_cast<char*>(footer.data()), footer.size());
+    index_offset_ = get_fixed(footer.data(), 8);
+    const auto num_blocks = get_fixed(footer.data() + 8, 4);
+    constexpr size_t kIndexEntrySize = 8 + 4 + 4;
+    if (!file_ || std::string_view(reinterpret_cast<const char*>(footer.data() + 12), kMagic.size()) != kMagic
+        || index_offset_ + num_blocks * kIndexEntrySize + kFooterSize != file_size) {
+        throw std::runtime_error(fmt::format("{}: corrupted compressed alg file footer", path));
+    }
+
+    std::vector<uint8_t> index_bytes(num_blocks * kIndexEntrySize);
+    file_.seekg(std::streamoff(index_offset_));
+    file_.read(reinterpret_cast<char*>(index_bytes.data()), std::streamsize(index_bytes.size()));
+    index_.reserve(num_blocks);
+    for (size_t i = 0; i < num_blocks; ++i) {
+        const uint8_t* entry = index_bytes.data() + i * kIndexEntrySize;
+        index_.push_back({get_fixed(entry, 8), uint32_t(get_fixed(entry + 8, 4)), uint32_t(get_fixed(entry + 12, 4))});
+        total_entries_ += index_.back().count;
+        const uint64_t block_end = (i + 1 < num_blocks) ? get_fixed(entry + kIndexEntrySize, 8) : index_offset_;
+        if (index_.back().offset >= block_end) {
+            throw std::runtime_error(fmt::format("{}: corrupted compressed alg file index", path));
+        }
+    }
+}
+
+std::vector<uint8_t> CompressedAlgFileReader::read_block_bytes(size_t block_index) {
+    const uint64_t begin = index_.at(block_index).offset;
+    const uint64_t end = (block_index + 1 < index_.size()) ? index_[block_index + 1].offset : index_offset_;
+    std::vector<uint8_t> bytes(end - begin);
+    file_.clear();
+    file_.seekg(std::streamoff(begin));
+    if (!file_.read(reinterpret_cast<char*>(bytes.data()), std::streamsize(bytes.size()))) {
+        throw std::runtime_error("compressed alg file: failed to read block");
+    }
+    return bytes;
+}
+
+void CompressedAlgFileReader::for_each_in_block(size_t block_index,
+                                                const std::function<void(const std::string&, const std::string&)>& callback) {
+    decode_block(read_block_bytes(block_index), callback);
+}
+
+std::optional<std::string> CompressedAlgFileReader::find(const std::string& pattern) {
+    const uint32_t pattern_index = pattern_to_index(pattern);
+    // last block that starts at or before the pattern
+    auto itr = std::upper_bound(index_.begin(), index_.end(), pattern_index,
+                                [](uint32_t value, const BlockInfo& block) {return value < block.first_pattern_index;});
+    if (itr == index_.begin()) {
+        return std::nullopt;
+    }
+    std::optional<std::string> result;
+    for_each_in_block(size_t(itr - index_.begin()) - 1, [&](const std::string& p, const std::string& alg) {
+        if (p == pattern) {
+            result = alg;
+        }
+    });
+    return result;
+}
+
+} // namespace cubing
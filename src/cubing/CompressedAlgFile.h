@@ -0,0 +1,75 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <optional>
+#include <fstream>
+#include <functional>
+#include <unordered_map>
+
+namespace cubing {
+
+static constexpr std::string_view COMPRESSED_ALGS_FILE_EXTENSION = ".algz";
+static constexpr size_t DEFAULT_ENTRIES_PER_BLOCK = 4096;
+
+/*
+ * Binary counterpart of the "pattern \t alg" text files. Layout (all fixed-width numbers are little-endian):
+ *
+ *   "ALGZ" u8:version
+ *   block 0, block 1, ...          each block: varint:count, then count * (varint:pattern_delta, alg_record)
+ *   index                          num_blocks * (u64:block_offset, u32:first_pattern_index, u32:count)
+ *   u64:index_offset u32:num_blocks "ALGZ"
+ *
+ * Patterns are sorted by pattern_to_index(); the first delta of every block is relative to 0, so any block can be
+ * decoded without the ones before it. alg_record is varint:(length << 1 | is_raw) followed by either <length> move
+ * tokens (one byte each, see encode_alg) or <length> raw bytes for algs that don't tokenize cleanly.
+ */
+
+/// @returns base-6 index of a 9-sticker WGROYB pattern, e.g. "WWWWWWWWW" -> 0
+/// @throws runtime_error if the pattern has wrong size or unknown colors
+uint32_t pattern_to_index(std::string_view pattern);
+std::string index_to_pattern(uint32_t index);
+
+/// @returns true if the file at @param path starts with the compressed file signature
+bool is_compressed_alg_file(const std::string& path);
+
+/// @returns false if the file can't be written. Entries are written sorted by pattern.
+/// @throws runtime_error if a pattern can't be encoded
+[[nodiscard]] bool save_compressed_alg_file(const std::string& path,
+                                            const std::unordered_map<std::string, std::string>& pattern_to_alg,
+                                            size_t entries_per_block = DEFAULT_ENTRIES_PER_BLOCK);
+
+/// @throws runtime_error if the file can't be read or is corrupted
+std::unordered_map<std::string, std::string> load_compressed_alg_file(const std::string& path);
+
+/// Random access to a compressed file: only the index is loaded on open, blocks are read on demand
+class CompressedAlgFileReader {
+public:
+    /// @throws runtime_error if the file can't be opened or is corrupted
+    explicit CompressedAlgFileReader(const std::string& path);
+
+    size_t num_blocks() const {return index_.size();}
+    size_t size() const {return total_entries_;}
+
+    /// decodes only the block that may contain @param pattern
+    std::optional<std::string> find(const std::string& pattern);
+
+    /// calls @param callback(pattern, alg) for every entry of block @param block_index, in sorted order
+    void for_each_in_block(size_t block_index, const std::function<void(const std::string&, const std::string&)>& callback);
+
+private:
+    struct BlockInfo {
+        uint64_t offset;
+        uint32_t first_pattern_index;
+        uint32_t count;
+    };
+    std::vector<uint8_t> read_block_bytes(size_t block_index);
+
+    std::ifstream file_;
+    std::vector<BlockInfo> index_;
+    uint64_t index_offset_{0};
+    size_t total_entries_{0};
+};
+
+} // namespace cubing
@@ -0,0 +1,139 @@
+#include "ConvenienceScore.h"
+#include "ScrambleProcessing.h"
+#include <algorithm>
+
+namespace cubing {
+
+template<QtmMoveSetSize qtmMoveSetSize>
+static MovesVector<qtmMoveSetSize> make_moves(std::initializer_list<uint8_t> codes) {
+    MovesVector<qtmMoveSetSize> moves;
+    for (const auto code : codes) {
+        moves.push_back(code);
+    }
+    return moves;
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+ConvenienceScorer<qtmMoveSetSize>::ConvenienceScorer() {
+    for (uint8_t a = 0; a < NUM_HTM_MOVES; ++a) {
+        single_[a] = execution_convenience_score_of_move(make_moves<qtmMoveSetSize>({a}).to_string());
+        min_share_[a] = single_[a];
+    }
+    if constexpr (qtmMoveSetSize == sidesAndMid333) {
+        // let to_string_combined_moves decide what gets combined, so that the scores always match it
+        const auto score_if_combined = [](const MovesVector<qtmMoveSetSize>& moves) -> uint16_t {
+            const auto combined = moves.to_string_combined_moves();
+            return combined.find(' ') == std::string::npos ? execution_convenience_score_of_move(combined) : NOT_COMBINED;
+        };
+        wide_.assign(NUM_HTM_MOVES * NUM_HTM_MOVES, NOT_COMBINED);
+        rotation_.assign(NUM_HTM_MOVES * NUM_HTM_MOVES * NUM_HTM_MOVES, NOT_COMBINED);
+        for (uint8_t a = 0; a < NUM_HTM_MOVES; ++a) {
+            for (uint8_t b = 0; b < NUM_HTM_MOVES; ++b) {
+                auto& wide = wide_[a * NUM_HTM_MOVES + b];
+                wide = score_if_combined(make_moves<qtmMoveSetSize>({a, b}));
+                if (wide != NOT_COMBINED) {
+                    min_share_[a] = std::min<uint16_t>(min_share_[a], wide / 2);
+                    min_share_[b] = std::min<uint16_t>(min_share_[b], wide / 2);
+                }
+                for (uint8_t c = 0; c < NUM_HTM_MOVES; ++c) {
+                    auto& rotation = rotation_[(a * NUM_HTM_MOVES + b) * NUM_HTM_MOVES + c];
+                    rotation = score_if_combined(make_moves<qtmMoveSetSize>({a, b, c}));
+                    if (rotation != NOT_COMBINED) {
+                        for (const auto m : {a, b, c}) {
+                            min_share_[m] = std::min<uint16_t>(min_share_[m], rotation / 3);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+const ConvenienceScorer<qtmMoveSetSize>& ConvenienceScorer<qtmMoveSetSize>::instance() {
+    static const ConvenienceScorer scorer;
+    return scorer;
+}
+
+/// @returns {score, number of moves} of the combined move at the start of @param moves, same as
+/// to_string_combined_moves: rotation if 3 moves combine, else wide move if 2 do, else a single move
+template<QtmMoveSetSize qtmMoveSetSize>
+static inline std::pair<uint32_t, size_t> first_combined_move(const uint8_t* moves, size_t size,
+                                                              const std::array<uint16_t, qtmMoveSetSize * 3>& single,
+                                                              const std::vector<uint16_t>& wide,
+                                                              const std::vector<uint16_t>& rotation) {
+    constexpr size_t kNumHtmMoves = qtmMoveSetSize * 3;
+    if constexpr (qtmMoveSetSize == sidesAndMid333) {
+        if (size >= 3) {
+            if (const auto score = rotation[(moves[0] * kNumHtmMoves + moves[1]) * kNumHtmMoves + moves[2]]; score) {
+                return {score, 3};
+            }
+        }
+        if (size >= 2) {
+            if (const auto score = wide[moves[0] * kNumHtmMoves + moves[1]]; score) {
+                return {score, 2};
+            }
+        }
+    }
+    return {single[moves[0]], 1};
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+uint32_t ConvenienceScorer<qtmMoveSetSize>::score(const MovesVector<qtmMoveSetSize>& moves) const {
+    uint32_t sum = 0;
+    const uint8_t* data = moves.begin();
+    for (size_t i = 0; i < moves.size(); ) {
+        const auto [score, num_moves] = first_combined_move<qtmMoveSetSize>(data + i, moves.size() - i, single_, wide_,
+                                                                            rotation_);
+        sum += score;
+        i += num_moves;
+    }
+    return sum;
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+typename ConvenienceScorer<qtmMoveSetSize>::PrefixScore
+ConvenienceScorer<qtmMoveSetSize>::append(PrefixScore prefix, uint8_t move) const {
+    if constexpr (qtmMoveSetSize != sidesAndMid333) {
+        prefix.committed += single_[move]; // nothing to combine
+        return prefix;
+    }
+    if (prefix.num_pending < prefix.pending.size()) {
+        prefix.pending[prefix.num_pending++] = move;
+        return prefix;
+    }
+    // 2 moves of lookahead are known now, so the first pending move can be resolved
+    const std::array<uint8_t, 3> moves = {prefix.pending[0], prefix.pending[1], move};
+    const auto [score, num_moves] = first_combined_move<qtmMoveSetSize>(moves.data(), moves.size(), single_, wide_,
+                                                                        rotation_);
+    prefix.committed += score;
+    prefix.num_pending = 0;
+    for (size_t i = num_moves; i < moves.size(); ++i) {
+        prefix.pending[prefix.num_pending++] = moves[i];
+    }
+    return prefix;
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+uint32_t ConvenienceScorer<qtmMoveSetSize>::finish(const PrefixScore& prefix) const {
+    uint32_t sum = prefix.committed;
+    for (size_t i = 0; i < prefix.num_pending; ) {
+        const auto [score, num_moves] = first_combined_move<qtmMoveSetSize>(prefix.pending.data() + i,
+                                                                            prefix.num_pending - i, single_, wide_,
+                                                                            rotation_);
+        sum += score;
+        i += num_moves;
+    }
+    return sum;
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+uint32_t ConvenienceScorer<qtmMoveSetSize>::lower_bound(const PrefixScore& prefix) const {
+    uint32_t sum = prefix.committed;
+    for (size_t i = 0; i < prefix.num_pending; ++i) {
+        sum += min_share_[prefix.pending[i]];
+    }
+    return sum;
+}
+
+} // namespace cubing
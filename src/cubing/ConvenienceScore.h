@@ -0,0 +1,55 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "CubingDefs.h"
+#include "MovesVector.h"
+
+namespace cubing {
+
+/*
+ * execution_convenience_score on move codes: score(moves) == execution_convenience_score(moves.to_string_combined_moves())
+ * for sidesAndMid333, and == execution_convenience_score(moves.to_string()) for the other move sets, which have no
+ * combined moves. All move, wide move and rotation scores are looked up in tables built once.
+ *
+ * Combining is greedy from the left and looks at most 2 moves ahead, so a prefix score (PrefixScore) keeps up to 2
+ * trailing moves pending until the moves after them are known. That lets a DFS keep a running score per depth and
+ * prune by lower_bound().
+ */
+template<QtmMoveSetSize qtmMoveSetSize>
+class ConvenienceScorer {
+public:
+    static constexpr size_t NUM_HTM_MOVES = qtmMoveSetSize * 3;
+
+    struct PrefixScore {
+        uint32_t committed{0}; // score of moves whose combining is already known
+        uint8_t num_pending{0};
+        std::array<uint8_t, 2> pending{};
+    };
+
+    static const ConvenienceScorer& instance();
+
+    uint32_t score(const MovesVector<qtmMoveSetSize>& moves) const;
+
+    /// @returns score of @param prefix followed by @param move
+    PrefixScore append(PrefixScore prefix, uint8_t move) const;
+    /// @returns score of the alg if it ends after the prefix
+    uint32_t finish(const PrefixScore& prefix) const;
+    /// @returns score that no alg starting with the prefix can beat
+    uint32_t lower_bound(const PrefixScore& prefix) const;
+
+private:
+    ConvenienceScorer();
+
+    static constexpr uint16_t NOT_COMBINED = 0;
+    std::array<uint16_t, NUM_HTM_MOVES> single_;
+    std::array<uint16_t, NUM_HTM_MOVES> min_share_; // lowest score a move may add as part of any combined move
+    std::vector<uint16_t> wide_;     // [a * NUM_HTM_MOVES + b]: score of <a b> combined into a wide move
+    std::vector<uint16_t> rotation_; // [(a * NUM_HTM_MOVES + b) * NUM_HTM_MOVES + c]: score of <a b c> as a rotation
+};
+
+template class ConvenienceScorer<sides333>;
+template class ConvenienceScorer<sidesAndMid333>;
+template class ConvenienceScorer<allMoves555>;
+
+} // namespace cubing
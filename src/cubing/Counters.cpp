@@ -0,0 +1,109 @@
+#include "Counters.h"
+#include <cstdio>
+#include <mutex>
+#include <unordered_set>
+#include <fmt/format.h>
+
+namespace cubing {
+
+static constexpr std::array<std::string_view, NUM_HOT_PATH_COUNTERS> kCounterNames = {
+    "moves_applied",
+    "corner_cycles_applied",
+    "edge_cycles_applied",
+    "x_center_cycles_applied",
+    "t_center_cycles_applied",
+    "wing_cycles_applied",
+    "cap_cycles_applied",
+    "scramble_increments",
+    "canonical_rejections",
+    "canonical_rescans",
+    "convenience_map_lookups",
+    "convenience_map_inserts",
+    "convenience_map_improvements",
+    "scramble_parses",
+    "scramble_parsed_moves",
+};
+
+std::string_view counter_name(HotPathCounter counter) {
+    return kCounterNames[size_t(counter)];
+}
+
+#ifdef CUBING_COUNTERS
+
+namespace detail {
+
+/// counters of running threads and the totals of exited ones; prints the totals when destroyed at exit
+class CountersRegistry {
+public:
+    static CountersRegistry& instance() {
+        static CountersRegistry registry;
+        return registry;
+    }
+    ~CountersRegistry() {
+        if (const auto report = counters_report(); !report.empty()) {
+            std::fprintf(stderr, "cubing counters at exit:\n%s", report.c_str());
+        }
+    }
+
+    void add(ThreadCounters* counters) {
+        std::lock_guard lock(mutex_);
+        running_.insert(counters);
+    }
+    void remove(ThreadCounters* counters) {
+        std::lock_guard lock(mutex_);
+        for (size_t i = 0; i < NUM_HOT_PATH_COUNTERS; ++i) {
+            exited_[i] += counters->values[i].load(std::memory_order_relaxed);
+        }
+        running_.erase(counters);
+    }
+    CountersSnapshot snapshot() {
+        std::lock_guard lock(mutex_);
+        CountersSnapshot result = exited_;
+        for (const auto* counters : running_) {
+            for (size_t i = 0; i < NUM_HOT_PATH_COUNTERS; ++i) {
+                result[i] += counters->values[i].load(std::memory_order_relaxed);
+            }
+        }
+        return result;
+    }
+
+private:
+    std::mutex mutex_;
+    std::unordered_set<ThreadCounters*> running_;
+    CountersSnapshot exited_{};
+};
+
+ThreadCounters::ThreadCounters() {
+    CountersRegistry::instance().add(this);
+}
+
+ThreadCounters::~ThreadCounters() {
+    CountersRegistry::instance().remove(this);
+}
+
+} // namespace detail
+
+CountersSnapshot counters_snapshot() {
+    return detail::CountersRegistry::instance().snapshot();
+}
+
+#else
+
+CountersSnapshot counters_snapshot() {
+    return {};
+}
+
+#endif
+
+std::string counters_report() {
+    const auto snapshot = counters_snapshot();
+    std::string result;
+    for (size_t i = 0; i < NUM_HOT_PATH_COUNTERS; ++i) {
+        if (snapshot[i] != 0) {
+            result += fmt::format("{}: {}\n", kCounterNames[i], snapshot[i]);
+        }
+    }
+    return result;
+}
+
+} // namespace cubing
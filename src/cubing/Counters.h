@@ -0,0 +1,80 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace cubing {
+
+/*
+ * Hot path counters, compiled in with the CUBING_COUNTERS cmake option (off by default). With counters off,
+ * CUBING_COUNT() expands to nothing and snapshots are all zeros.
+ *
+ * Each thread counts into its own counters without synchronization; counters_snapshot() sums up all threads,
+ * including exited ones. The totals are printed to stderr at exit, and tools may print counters_report() at their
+ * checkpoints.
+ */
+enum class HotPathCounter : uint8_t {
+    movesApplied,           // CubeState::applyScrambleMove calls
+    cornerCyclesApplied,    // moves applied per orbit, i.e. cycles actually performed by these moves
+    edgeCyclesApplied,
+    xCenterCyclesApplied,
+    tCenterCyclesApplied,
+    wingCyclesApplied,
+    capCyclesApplied,
+    scrambleIncrements,     // IterativeScramble::operator++ calls
+    canonicalRejections,    // algs skipped by IterativeScramble because of unsorted parallel moves
+    canonicalRescans,       // moves checked again after the parallel moves check restarted from the first move
+    convenienceMapLookups,  // PatternToAlgAndConvenienceMap::insert_if_more_convenient calls
+    convenienceMapInserts,  // new patterns
+    convenienceMapImprovements, // more convenient algs for known patterns
+    scrambleParses,         // ScrambleParser::parse / try_parse calls
+    scrambleParsedMoves,
+    numCounters
+};
+static constexpr size_t NUM_HOT_PATH_COUNTERS = size_t(HotPathCounter::numCounters);
+using CountersSnapshot = std::array<uint64_t, NUM_HOT_PATH_COUNTERS>;
+
+constexpr bool counters_enabled() {
+#ifdef CUBING_COUNTERS
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::string_view counter_name(HotPathCounter counter);
+
+/// @returns sums over all threads
+CountersSnapshot counters_snapshot();
+
+/// @returns "name: value" line per non-zero counter, empty string if counters are compiled out
+std::string counters_report();
+
+#ifdef CUBING_COUNTERS
+namespace detail {
+
+struct ThreadCounters {
+    ThreadCounters();  // registers for snapshots
+    ~ThreadCounters(); // adds counts to the totals of exited threads
+    // only written by the owning thread, so a relaxed load + store is enough, without a locked read-modify-write
+    std::array<std::atomic<uint64_t>, NUM_HOT_PATH_COUNTERS> values{};
+};
+inline thread_local ThreadCounters thread_counters;
+
+inline void count(HotPathCounter counter, uint64_t n) {
+    auto& value = thread_counters.values[size_t(counter)];
+    value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+} // namespace detail
+
+#define CUBING_COUNT_N(counter, n) ::cubing::detail::count(::cubing::HotPathCounter::counter, (n))
+#else
+#define CUBING_COUNT_N(counter, n) static_cast<void>(0)
+#endif
+
+#define CUBING_COUNT(counter) CUBING_COUNT_N(counter, 1)
+
+} // namespace cubing
@@ -5,9 +5,28 @@
 #include <vector>
 #include <fmt/format.h>
 #include "ScrambleProcessing.h"
+#include "ScrambleParser.h"
+#include "Counters.h"
 
 namespace cubing {
 
+template<QtmMoveSetSize moveSetSize>
+std::string CubeState<moveSetSize>::differingOrbits(const CubeState& other) const {
+    std::vector<std::string> result;
+    const auto check = [&](bool same, const char* orbit) {
+        if (!same) {
+            result.emplace_back(orbit);
+        }
+    };
+    check(cornersState_ == other.cornersState_, "corners");
+    check(edgesState_ == other.edgesState_, "edges");
+    check(xCentersState_ == other.xCentersState_, "x-centers");
+    check(tCentersState_ == other.tCentersState_, "t-centers");
+    check(wingsState_ == other.wingsState_, "wings");
+    check(capsState_ == other.capsState_, "caps");
+    return strutil::join(result, ", ");
+}
+
 template<QtmMoveSetSize moveSetSize>
 bool CubeState<moveSetSize>::isSolved() const {
     return
@@ -161,20 +180,7 @@ void CubeState<moveSetSize>::performEdgesCycle(const std::vector<uint8_t>& cycle
 
 template<QtmMoveSetSize moveSetSize>
 void CubeState<moveSetSize>::applyScramble(const std::string& scramble) {
-    const std::vector<std::string> initialList = strutil::split(scramble, ' ');
-    std::vector<std::string> list; // does not contain rotations
-    for (const std::string& move : initialList) {
-        if (isRotationLetter(move.front())) {
-            const auto moves = rotationToMoves(move, moveSetSize == allMoves555 ? 5 : 3);
-            for (const auto& m : moves) {
-                list.push_back(m);
-            }
-        } else if (!move.empty()) {
-            list.push_back(move);
-        }
-    }
-
-    applyScramble(MovesVector<moveSetSize>::from_string(list));
+    applyScramble(ScrambleParser<moveSetSize>::parse(scramble));
 }
 
 template<QtmMoveSetSize moveSetSize>
@@ -189,6 +195,13 @@ void CubeState<qtmMoveSetSize>::applyScrambleMove(uint8_t move) {
     const uint8_t prime = move / qtmMoveSetSize; // 0: qtm; 1: double; 2: prime
     move = move % qtmMoveSetSize;
     const auto& vec = scrambleMap[move];
+    CUBING_COUNT(movesApplied);
+    CUBING_COUNT_N(cornerCyclesApplied, !vec[0].empty());
+    CUBING_COUNT_N(edgeCyclesApplied, !vec[1].empty());
+    CUBING_COUNT_N(xCenterCyclesApplied, !vec[2].empty() + !vec[3].empty());
+    CUBING_COUNT_N(tCenterCyclesApplied, !vec[4].empty() + !vec[5].empty());
+    CUBING_COUNT_N(wingCyclesApplied, !vec[6].empty() + !vec[7].empty());
+    CUBING_COUNT_N(capCyclesApplied, !vec[8].empty());
     performCornersCycle(vec[0], prime);
     performEdgesCycle(vec[1], prime);
     performCentersCycle(xCentersState_, vec[2], prime);
@@ -200,6 +213,86 @@ void CubeState<qtmMoveSetSize>::applyScrambleMove(uint8_t move) {
     performCentersCycle(capsState_, vec[8], prime); // caps
 }
 
+template<QtmMoveSetSize moveSetSize>
+CubeState<moveSetSize> CubeState<moveSetSize>::identityPermutation() {
+    CubeState result;
+    // x/t-centers, wings and caps are already labelled by position
+    std::iota(result.cornersState_.begin(), result.cornersState_.end(), 0);
+    std::iota(result.edgesState_.begin(), result.edgesState_.end(), 0);
+    return result;
+}
+
+template<QtmMoveSetSize moveSetSize>
+CubeState<moveSetSize> CubeState<moveSetSize>::compileAlgorithm(const MovesVector<moveSetSize>& moves) {
+    auto result = identityPermutation();
+    result.applyScramble(moves);
+    return result;
+}
+
+template<QtmMoveSetSize moveSetSize>
+CubeState<moveSetSize> CubeState<moveSetSize>::compileAlgorithm(const std::string& alg) {
+    auto result = identityPermutation();
+    result.applyScramble(alg);
+    return result;
+}
+
+// moves only relocate stickers, so any state S after permutation P becomes S'[i] = S[P[i]]
+template<class ElementsState>
+static inline void permuteElements(ElementsState& state, const ElementsState& permutation) {
+    const ElementsState source = state;
+    for (size_t i = 0; i < state.size(); ++i) {
+        state[i] = source[permutation[i]];
+    }
+}
+
+template<class ElementsState>
+static inline void permuteElementsInverse(ElementsState& state, const ElementsState& permutation) {
+    const ElementsState source = state;
+    for (size_t i = 0; i < state.size(); ++i) {
+        state[permutation[i]] = source[i];
+    }
+}
+
+template<class ElementsState>
+static inline void invertElements(ElementsState& state) {
+    const ElementsState source = state;
+    for (size_t i = 0; i < state.size(); ++i) {
+        state[source[i]] = i;
+    }
+}
+
+template<QtmMoveSetSize moveSetSize>
+void CubeState<moveSetSize>::applyPermutation(const CubeState& permutation) {
+    permuteElements(cornersState_, permutation.cornersState_);
+    permuteElements(edgesState_, permutation.edgesState_);
+    permuteElements(xCentersState_, permutation.xCentersState_);
+    permuteElements(tCentersState_, permutation.tCentersState_);
+    permuteElements(wingsState_, permutation.wingsState_);
+    permuteElements(capsState_, permutation.capsState_);
+}
+
+template<QtmMoveSetSize moveSetSize>
+void CubeState<moveSetSize>::applyInversePermutation(const CubeState& permutation) {
+    permuteElementsInverse(cornersState_, permutation.cornersState_);
+    permuteElementsInverse(edgesState_, permutation.edgesState_);
+    permuteElementsInverse(xCentersState_, permutation.xCentersState_);
+    permuteElementsInverse(tCentersState_, permutation.tCentersState_);
+    permuteElementsInverse(wingsState_, permutation.wingsState_);
+    permuteElementsInverse(capsState_, permutation.capsState_);
+}
+
+template<QtmMoveSetSize moveSetSize>
+CubeState<moveSetSize> CubeState<moveSetSize>::inversePermutation() const {
+    CubeState result = *this;
+    invertElements(result.cornersState_);
+    invertElements(result.edgesState_);
+    invertElements(result.xCentersState_);
+    invertElements(result.tCentersState_);
+    invertElements(result.wingsState_);
+    invertElements(result.capsState_);
+    return result;
+}
+
 template<QtmMoveSetSize moveSetSize>
 bool CubeState<moveSetSize>::isCorrectlyOriented() const {
     return capsState_.empty() || capsState_ == capsStateInitial;
@@ -18,6 +18,11 @@ public:
     CubeState& operator=(const CubeState& other) = default;
     CubeState& operator=(CubeState&& other) noexcept = default;
 
+    bool operator==(const CubeState& other) const = default;
+
+    /// @returns comma-separated names of orbits that differ from @param other, e.g. "corners, wings"; empty if equal
+    std::string differingOrbits(const CubeState& other) const;
+
     bool isSolved() const;
 
     /// = caps solved
@@ -38,6 +43,13 @@ public:
     /// @returns true if each sticker on the front face has the opposite color as the corresponding sticker on the back face
     bool doFrontAndBackSidesHaveSamePatternWithOppositeColors() const;
 
+    /// orbits holding the stickers of 3x3 faces: colors of corner stickers (3 per corner), edge stickers (2 per edge)
+    /// and centers. See FacePatternPredicate for which index is which sticker.
+    enum StickerOrbit : uint8_t {cornerStickers, edgeStickers, centerStickers};
+    const uint8_t* stickerColors(StickerOrbit orbit) const {
+        return orbit == cornerStickers ? cornersState_.data() : orbit == edgeStickers ? edgesState_.data() : capsState_.data();
+    }
+
     /* scrambling*/
     void applyScramble(const std::string& scramble);
 
@@ -45,6 +57,27 @@ public:
 
     void applyScrambleMove(uint8_t move);
 
+    /* permutations */
+    /// @returns state where each sticker holds its own position index instead of a color. Moves applied to it turn it
+    /// into a permutation (a "compiled" algorithm) that can be applied to any state with applyPermutation().
+    /// Color-based methods (isSolved(), frontSideStickers() etc.) are meaningless for such states.
+    static CubeState identityPermutation();
+
+    /// @returns permutation equivalent to applying @param moves one by one
+    static CubeState compileAlgorithm(const MovesVector<qtmMoveSetSize>& moves);
+    static CubeState compileAlgorithm(const std::string& alg);
+
+    /// applies compiled algorithm @param permutation to this state, i.e. for A and B compiled algorithms,
+    /// A.applyPermutation(B) == compileAlgorithm(A B)
+    void applyPermutation(const CubeState& permutation);
+
+    /// @returns permutation that undoes this one; only valid for permutation states
+    CubeState inversePermutation() const;
+
+    /// same as applyPermutation(permutation.inversePermutation()), without building the inverse. Applied to a solved
+    /// cube, gives the state of the inverted algorithm, i.e. of invertScramble(alg) for permutation compileAlgorithm(alg)
+    void applyInversePermutation(const CubeState& permutation);
+
     /* corner manipulation */
     void twistCorner(uint8_t cornerNumber, bool clockwise = true);
 
@@ -0,0 +1,167 @@
+#include "DifferentialTesting.h"
+#include <chrono>
+#include <random>
+#include <fmt/format.h>
+
+namespace cubing {
+
+template<QtmMoveSetSize qtmMoveSetSize>
+DifferentialTester<qtmMoveSetSize>::DifferentialTester(std::vector<Engine> engines) : engines_(std::move(engines)) {
+    if (engines_.empty()) {
+        throw std::runtime_error("DifferentialTester: no reference engine");
+    }
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+std::vector<CubeEngine<qtmMoveSetSize>> DifferentialTester<qtmMoveSetSize>::builtin_engines() {
+    using State = CubeState<qtmMoveSetSize>;
+    std::vector<State> move_permutations;
+    for (uint8_t move = 0; move < qtmMoveSetSize * 3; ++move) {
+        Moves single_move;
+        single_move.push_back(move);
+        move_permutations.push_back(State::compileAlgorithm(single_move));
+    }
+    return {
+        {"reference", [](const Moves& moves) {
+            State cube;
+            for (const auto move : moves) {
+                cube.applyScrambleMove(move);
+            }
+            return cube;
+        }},
+        {"move permutations", [move_permutations](const Moves& moves) {
+            State cube;
+            for (const auto move : moves) {
+                cube.applyPermutation(move_permutations[move]);
+            }
+            return cube;
+        }},
+        {"compiled alg", [](const Moves& moves) {
+            State cube;
+            cube.applyPermutation(State::compileAlgorithm(moves));
+            return cube;
+        }},
+        {"parsed string", [](const Moves& moves) {
+            State cube;
+            cube.applyScramble(moves.to_string());
+            return cube;
+        }},
+    };
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+std::string DifferentialTester<qtmMoveSetSize>::describe_mismatch(const CubeState<qtmMoveSetSize>& expected,
+                                                                  const CubeState<qtmMoveSetSize>& actual) {
+    std::string result;
+    if (const auto orbits = expected.differingOrbits(actual); !orbits.empty()) {
+        result += fmt::format("orbits differ: {}", orbits);
+    }
+    const auto compare = [&](const std::string& what, const auto& expected_value, const auto& actual_value) {
+        if (expected_value != actual_value) {
+            result += fmt::format("{}{}: expected {}, got {}", result.empty() ? "" : "; ", what, expected_value,
+                                  actual_value);
+        }
+    };
+    compare("front side", expected.frontSideStickers(), actual.frontSideStickers());
+    compare("top side", expected.topSideStickers(), actual.topSideStickers());
+    compare("front and back sides match", expected.doFrontAndBackSidesHaveSamePatternWithOppositeColors(),
+            actual.doFrontAndBackSidesHaveSamePatternWithOppositeColors());
+    return result;
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+MovesVector<qtmMoveSetSize> DifferentialTester<qtmMoveSetSize>::minimize(const Moves& moves,
+                                                                         const std::function<bool(const Moves&)>& fails) {
+    const auto slice = [](const Moves& source, size_t begin, size_t end, bool complement) {
+        Moves result;
+        for (size_t i = 0; i < source.size(); ++i) {
+            if ((i >= begin && i < end) != complement) {
+                result.push_back(source[i]);
+            }
+        }
+        return result;
+    };
+    Moves current = moves;
+    size_t num_chunks = 2;
+    while (current.size() >= 2) {
+        const size_t chunk_size = (current.size() + num_chunks - 1) / num_chunks;
+        bool reduced = false;
+        for (size_t begin = 0; begin < current.size() && !reduced; begin += chunk_size) {
+            const size_t end = std::min(begin + chunk_size, current.size());
+            if (auto chunk = slice(current, begin, end, false); fails(chunk)) {
+                current = std::move(chunk);
+                num_chunks = 2;
+                reduced = true;
+            } else if (auto complement = slice(current, begin, end, true); fails(complement)) {
+                current = std::move(complement);
+                num_chunks = std::max<size_t>(num_chunks - 1, 2);
+                reduced = true;
+            }
+        }
+        if (!reduced) {
+            if (num_chunks >= current.size()) {
+                break; // single moves can't be removed anymore
+            }
+            num_chunks = std::min(num_chunks * 2, current.size());
+        }
+    }
+    if (current.size() == 1 && fails(Moves{})) {
+        return {};
+    }
+    return current;
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+std::vector<EngineReport> DifferentialTester<qtmMoveSetSize>::run(const DifferentialTestOptions& options) const {
+    std::mt19937_64 rng(options.seed);
+    std::uniform_int_distribution<size_t> random_size(0, options.max_moves);
+    std::uniform_int_distribution<int> random_move(0, qtmMoveSetSize * 3 - 1); // char types aren't valid IntTypes
+    std::vector<Moves> sequences(options.num_sequences);
+    size_t num_moves = 0;
+    for (auto& sequence : sequences) {
+        const size_t size = random_size(rng);
+        for (size_t i = 0; i < size; ++i) {
+            sequence.push_back(uint8_t(random_move(rng)));
+        }
+        num_moves += size;
+    }
+
+    const auto& reference = engines_.front();
+    std::vector<CubeState<qtmMoveSetSize>> expected;
+    expected.reserve(sequences.size());
+    for (const auto& sequence : sequences) {
+        expected.push_back(reference.scramble(sequence));
+    }
+
+    std::vector<EngineReport> reports;
+    for (const auto& engine : engines_) {
+        EngineReport report;
+        report.name = engine.name;
+        for (size_t i = 0; i < sequences.size(); ++i) {
+            if (describe_mismatch(expected[i], engine.scramble(sequences[i])).empty()) {
+                continue;
+            }
+            if (report.num_mismatches++ == 0) {
+                const auto mismatches = [&](const Moves& moves) {
+                    return !describe_mismatch(reference.scramble(moves), engine.scramble(moves)).empty();
+                };
+                const auto counterexample = minimize(sequences[i], mismatches);
+                report.counterexample = counterexample.to_string();
+                report.mismatch = describe_mismatch(reference.scramble(counterexample), engine.scramble(counterexample));
+            }
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        // reported, so that the timed results aren't optimized away
+        for (const auto& sequence : sequences) {
+            report.num_mosaics += engine.scramble(sequence).doFrontAndBackSidesHaveSamePatternWithOppositeColors();
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        report.moves_per_second = num_moves / std::max(seconds, 1e-9);
+        report.speedup = reports.empty() ? 1. : report.moves_per_second / reports.front().moves_per_second;
+        reports.push_back(std::move(report));
+    }
+    return reports;
+}
+
+} // namespace cubing
@@ -0,0 +1,73 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "CubingDefs.h"
+#include "CubeState.h"
+#include "MovesVector.h"
+
+namespace cubing {
+
+/// Move engine under test: anything that turns a sequence of move codes into a CubeState
+template<QtmMoveSetSize qtmMoveSetSize>
+struct CubeEngine {
+    std::string name;
+    /// @returns state of a solved cube after @param moves
+    std::function<CubeState<qtmMoveSetSize>(const MovesVector<qtmMoveSetSize>&)> scramble;
+};
+
+struct DifferentialTestOptions {
+    size_t num_sequences{10'000};
+    size_t max_moves{40}; // sequence sizes are uniform in [0, max_moves]
+    uint64_t seed{1};
+};
+
+struct EngineReport {
+    std::string name;
+    size_t num_mismatches{0};
+    std::string counterexample; // minimized alg of the first mismatch
+    std::string mismatch;       // what differs for the counterexample
+    double moves_per_second{0};
+    double speedup{1};          // over the reference engine
+    size_t num_mosaics{0};      // timed sequences ending in a two-sided mosaic, same for all matching engines
+};
+
+/*
+ * Drives the same random move sequences through a reference engine and the engines under test, and compares all
+ * orbits as well as the front/top face patterns. Mismatching sequences are shrunk by delta debugging to a 1-minimal
+ * counterexample. Every engine is also timed on the same sequences, so the report doubles as a throughput comparison.
+ */
+template<QtmMoveSetSize qtmMoveSetSize>
+class DifferentialTester {
+public:
+    using Engine = CubeEngine<qtmMoveSetSize>;
+    using Moves = MovesVector<qtmMoveSetSize>;
+
+    /// @param engines : the first one is the reference
+    explicit DifferentialTester(std::vector<Engine> engines);
+
+    /// reference (CubeState::applyScrambleMove per move), per-move permutations, compiled alg permutation and parsing
+    /// of the alg string
+    static std::vector<Engine> builtin_engines();
+
+    /// @returns one report per engine, the reference included
+    std::vector<EngineReport> run(const DifferentialTestOptions& options) const;
+
+    /// @returns what differs between @param expected and @param actual, empty string if nothing
+    static std::string describe_mismatch(const CubeState<qtmMoveSetSize>& expected,
+                                         const CubeState<qtmMoveSetSize>& actual);
+
+    /// ddmin: @returns subsequence of @param moves that still @param fails, such that removing any single move from
+    /// it makes the failure go away. @param moves must fail.
+    static Moves minimize(const Moves& moves, const std::function<bool(const Moves&)>& fails);
+
+private:
+    std::vector<Engine> engines_;
+};
+
+template class DifferentialTester<sides333>;
+template class DifferentialTester<sidesAndMid333>;
+template class DifferentialTester<allMoves555>;
+
+} // namespace cubing
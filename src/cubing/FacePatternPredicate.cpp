@@ -0,0 +1,163 @@
+#include "FacePatternPredicate.h"
+#include "Helpers.h"
+#include <strutil.h>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <fmt/format.h>
+
+namespace cubing {
+
+namespace {
+
+constexpr uint8_t C = CubeState<sides333>::cornerStickers;
+constexpr uint8_t E = CubeState<sides333>::edgeStickers;
+constexpr uint8_t X = CubeState<sides333>::centerStickers;
+
+constexpr std::string_view kFaces = "UFRLDB";
+constexpr std::string_view kColors = "WGROYB";
+constexpr std::array<uint8_t, 6> kOppositeFace = {4, 5, 3, 2, 0, 1}; // same as opposite colors
+constexpr std::array<uint8_t, 8> kPositionsAroundCenter = {0, 1, 2, 3, 5, 6, 7, 8};
+
+// stickers of each face in reading order, see FacePatternPredicate
+constexpr std::array<std::array<FaceSticker, 9>, 6> kFaceStickers = {{
+    {{{C, 5}, {E, 6}, {C, 8}, {E, 2}, {X, 0}, {E, 4}, {C, 2}, {E, 0}, {C, 11}}},      // U, B up
+    {{{C, 0}, {E, 1}, {C, 10}, {E, 16}, {X, 1}, {E, 18}, {C, 12}, {E, 9}, {C, 23}}},  // F
+    {{{C, 9}, {E, 5}, {C, 7}, {E, 19}, {X, 2}, {E, 23}, {C, 21}, {E, 13}, {C, 20}}},  // R
+    {{{C, 3}, {E, 3}, {C, 1}, {E, 21}, {X, 3}, {E, 17}, {C, 15}, {E, 11}, {C, 14}}},  // L
+    {{{C, 13}, {E, 8}, {C, 22}, {E, 10}, {X, 4}, {E, 12}, {C, 16}, {E, 14}, {C, 19}}}, // D, F up
+    {{{C, 6}, {E, 7}, {C, 4}, {E, 22}, {X, 5}, {E, 20}, {C, 18}, {E, 15}, {C, 17}}},  // B
+}};
+
+} // namespace
+
+// used by the parser of the class template, so not in the anonymous namespace
+namespace detail {
+
+struct FaceSelection {
+    uint8_t face;
+    bool around_center; // 8 stickers
+    std::vector<uint8_t> positions() const {
+        return around_center ? std::vector<uint8_t>(kPositionsAroundCenter.begin(), kPositionsAroundCenter.end())
+                             : std::vector<uint8_t>{0, 1, 2, 3, 4, 5, 6, 7, 8};
+    }
+};
+
+/// @returns position on the opposite face that faces @param position through the cube
+uint8_t position_through_cube(uint8_t face, uint8_t position) {
+    const uint8_t row = position / 3, column = position % 3;
+    const bool up_or_down = face == 0 || face == 4; // U and D views are flipped vertically, side faces horizontally
+    return up_or_down ? (2 - row) * 3 + column : row * 3 + (2 - column);
+}
+
+} // namespace detail
+
+using detail::FaceSelection;
+using detail::position_through_cube;
+
+template<QtmMoveSetSize qtmMoveSetSize>
+FacePatternPredicate<qtmMoveSetSize> FacePatternPredicate<qtmMoveSetSize>::compile(std::string_view spec) {
+    FacePatternPredicate result;
+    std::optional<FaceSelection> key, first_face;
+    std::istringstream lines{std::string(spec)};
+    std::string line;
+    for (size_t line_number = 1; std::getline(lines, line); ++line_number) {
+        const auto fail = [&](const std::string& message) {
+            return std::runtime_error(fmt::format("face pattern predicate, line {}: {} in <{}>", line_number, message,
+                                                  line));
+        };
+        const auto parse_face = [&](const std::string& token) {
+            const auto face = kFaces.find(token.empty() ? ' ' : token[0]);
+            if (face == std::string_view::npos || token.size() > 2 || (token.size() == 2 && token[1] != '8')) {
+                throw fail(fmt::format("invalid face <{}>, expected one of U F R L D B, optionally followed by 8", token));
+            }
+            const FaceSelection selection{uint8_t(face), token.size() == 2};
+            if (!first_face) {
+                first_face = selection;
+            }
+            return selection;
+        };
+
+        std::vector<std::string> tokens;
+        std::istringstream words(line.substr(0, line.find('#')));
+        for (std::string word; words >> word; ) {
+            tokens.push_back(word);
+        }
+        if (tokens.empty()) {
+            continue;
+        }
+        const auto& rule = tokens[0];
+        if (rule == "key" && tokens.size() == 2) {
+            key = parse_face(tokens[1]);
+        } else if ((rule == "equal" || rule == "opposite") && tokens.size() == 3) {
+            const auto lhs = parse_face(tokens[1]), rhs = parse_face(tokens[2]);
+            if (lhs.around_center != rhs.around_center) {
+                throw fail("faces must both have 9 or both have 8 stickers");
+            }
+            const bool through_cube = kOppositeFace[lhs.face] == rhs.face;
+            for (const auto position : lhs.positions()) {
+                Check check{kFaceStickers[lhs.face][position],
+                            kFaceStickers[rhs.face][through_cube ? position_through_cube(lhs.face, position) : position],
+                            {}};
+                for (uint8_t color = 0; color < 6; ++color) {
+                    check.expected[color] = rule == "equal" ? color : kOppositeFace[color];
+                }
+                result.checks_.push_back(check);
+            }
+        } else if (rule == "fixed" && tokens.size() == 3) {
+            const auto face = parse_face(tokens[1]);
+            const auto& colors = tokens[2];
+            const auto positions = face.positions();
+            if (colors.size() != positions.size()) {
+                throw fail(fmt::format("expected {} colors", positions.size()));
+            }
+            for (size_t i = 0; i < positions.size(); ++i) {
+                if (colors[i] == '?') {
+                    continue;
+                }
+                const auto color = kColors.find(colors[i]);
+                if (color == std::string_view::npos) {
+                    throw fail(fmt::format("invalid color <{}>, expected one of WGROYB or ?", colors[i]));
+                }
+                // the sticker is compared to itself: whatever its color, it must be the fixed one
+                const auto sticker = kFaceStickers[face.face][positions[i]];
+                Check check{sticker, sticker, {}};
+                check.expected.fill(uint8_t(color));
+                result.checks_.push_back(check);
+            }
+        } else {
+            throw fail("expected key <face>, equal <face> <face>, opposite <face> <face> or fixed <face> <colors>");
+        }
+    }
+    if (!key) {
+        key = first_face;
+    }
+    if (!key) {
+        throw std::runtime_error("face pattern predicate: no rules");
+    }
+    for (const auto position : key->positions()) {
+        result.key_stickers_.push_back(kFaceStickers[key->face][position]);
+    }
+    return result;
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+FacePatternPredicate<qtmMoveSetSize> FacePatternPredicate<qtmMoveSetSize>::load_from_file(const std::string& path) {
+    const auto lines = getFileContentsAsLines(path, true);
+    if (lines.empty()) {
+        throw std::runtime_error(fmt::format("face pattern predicate: failed to read {}", path));
+    }
+    return compile(strutil::join(lines, "\n"));
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+std::string FacePatternPredicate<qtmMoveSetSize>::key(const CubeState<qtmMoveSetSize>& cube) const {
+    std::string result(key_stickers_.size(), ' ');
+    for (size_t i = 0; i < key_stickers_.size(); ++i) {
+        const auto& sticker = key_stickers_[i];
+        result[i] = kColors[cube.stickerColors(typename CubeState<qtmMoveSetSize>::StickerOrbit(sticker.orbit))[sticker.index]];
+    }
+    return result;
+}
+
+} // namespace cubing
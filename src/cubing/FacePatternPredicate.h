@@ -0,0 +1,77 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "CubingDefs.h"
+#include "CubeState.h"
+
+namespace cubing {
+
+/// spec of the two-sided mosaic search: same pattern with opposite colors on F and B, keyed by F stickers
+static constexpr std::string_view TWO_SIDED_MOSAIC_PREDICATE = "key F\nopposite F B\n";
+
+/// sticker of a 3x3 face, index into CubeState::stickerColors(orbit)
+struct FaceSticker {
+    uint8_t orbit; // CubeState::StickerOrbit
+    uint8_t index;
+};
+
+/*
+ * Declarative face pattern predicate, one rule per line, '#' starts a comment:
+ *   key <face>                  stickers that make up the pattern string; defaults to the first face of the first rule
+ *   equal <face> <face>         corresponding stickers have the same color
+ *   opposite <face> <face>      corresponding stickers have opposite colors
+ *   fixed <face> <colors>       stickers have the given colors (WGROYB, '?' for any), e.g. "fixed U ????W????"
+ * Faces are U F R L D B; a face followed by 8 (e.g. F8) means the 8 stickers around its center instead of all 9.
+ * Stickers of a face are in reading order looking at the face, with U up for side faces, B up for U and F up for D.
+ * Stickers of opposite faces correspond if they face each other through the cube (FUL and BUL); stickers of adjacent
+ * faces correspond if they are at the same position.
+ *
+ * Compiled, a predicate is a list of (sticker, sticker, color table) checks, the same for all rules, so checking a
+ * cube gathers sticker colors without branching on the rule kind.
+ */
+template<QtmMoveSetSize qtmMoveSetSize>
+class FacePatternPredicate {
+public:
+    /// @throws runtime_error with the line number if @param spec is invalid
+    static FacePatternPredicate compile(std::string_view spec);
+    /// @throws runtime_error if the file can't be read or is invalid
+    static FacePatternPredicate load_from_file(const std::string& path);
+
+    bool matches(const CubeState<qtmMoveSetSize>& cube) const {
+        const std::array<const uint8_t*, 3> orbits = {
+            cube.stickerColors(CubeState<qtmMoveSetSize>::cornerStickers),
+            cube.stickerColors(CubeState<qtmMoveSetSize>::edgeStickers),
+            cube.stickerColors(CubeState<qtmMoveSetSize>::centerStickers)};
+        for (const auto& check : checks_) {
+            if (check.expected[orbits[check.lhs.orbit][check.lhs.index]] != orbits[check.rhs.orbit][check.rhs.index]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @returns colors of the key stickers (WGROYB), e.g. same as CubeState::frontSideStickers() for "key F"
+    std::string key(const CubeState<qtmMoveSetSize>& cube) const;
+    size_t num_key_stickers() const {return key_stickers_.size();}
+    size_t num_checks() const {return checks_.size();}
+
+    struct Check {
+        FaceSticker lhs, rhs;
+        std::array<uint8_t, 6> expected; // color of rhs must be expected[color of lhs]
+    };
+    /// in rule order, e.g. "opposite F B" gives the F stickers in reading order as lhs
+    const std::vector<Check>& checks() const {return checks_;}
+
+private:
+    std::vector<Check> checks_;
+    std::vector<FaceSticker> key_stickers_;
+};
+
+template class FacePatternPredicate<sides333>;
+template class FacePatternPredicate<sidesAndMid333>;
+template class FacePatternPredicate<allMoves555>;
+
+} // namespace cubing
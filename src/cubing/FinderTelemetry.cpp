@@ -0,0 +1,142 @@
+#include "FinderTelemetry.h"
+#include "Helpers.h"
+#include <filesystem>
+#include <fmt/format.h>
+
+namespace cubing {
+
+static double seconds_between(FinderTelemetry::Clock::time_point from, FinderTelemetry::Clock::time_point to) {
+    return std::chrono::duration<double>(to - from).count();
+}
+
+/// @returns @param numerator / @param denominator, or 0 if there is nothing to divide by, so that JSON stays valid
+static double ratio(double numerator, double denominator) {
+    return denominator > 0 ? numerator / denominator : 0.;
+}
+
+FinderTelemetry::FinderTelemetry(Clock::time_point start) :
+    start_(start), depth_start_(start), last_update_(start) {}
+
+void FinderTelemetry::update(size_t depth, double depth_progress, size_t num_patterns_found, size_t num_patterns_total,
+                             Clock::time_point now) {
+    const auto current = totals();
+    recent_seconds_ = seconds_between(last_update_, now);
+    recent_ = {current.candidates - last_update_totals_.candidates,
+               current.moves_applied - last_update_totals_.moves_applied,
+               current.hits - last_update_totals_.hits,
+               current.improvements - last_update_totals_.improvements};
+    last_update_ = now;
+    last_update_totals_ = current;
+    depth_progress_ = depth_progress;
+    num_patterns_found_ = num_patterns_found;
+    num_patterns_total_ = num_patterns_total;
+
+    // depth boundaries are only as precise as the update interval: everything since the previous update is counted
+    // towards the depth that was current then
+    const auto close_current_depth = [&](bool completed) {
+        auto& stats = depths_.back();
+        stats.candidates = current.candidates - depth_start_totals_.candidates;
+        stats.hits = current.hits - depth_start_totals_.hits;
+        stats.improvements = current.improvements - depth_start_totals_.improvements;
+        stats.seconds = seconds_between(depth_start_, now);
+        stats.completed = completed;
+    };
+    if (!depths_.empty() && depths_.back().depth != depth) {
+        close_current_depth(true);
+        depths_.push_back({.depth = depth});
+        depth_start_ = now;
+        depth_start_totals_ = current;
+    } else if (depths_.empty()) {
+        depths_.push_back({.depth = depth});
+    }
+    close_current_depth(false);
+}
+
+double FinderTelemetry::projected_seconds_left_in_depth() const {
+    if (depths_.empty() || depth_progress_ <= 0.) {
+        return -1.;
+    }
+    return depths_.back().seconds * (1. - depth_progress_) / depth_progress_;
+}
+
+std::string FinderTelemetry::to_json() const {
+    const double elapsed = seconds_between(start_, last_update_);
+    std::string depths;
+    for (const auto& stats : depths_) {
+        depths += fmt::format(R"({}    {{"depth": {}, "candidates": {}, "hits": {}, "improvements": {}, )"
+                              R"("seconds": {:.3f}, "candidates_per_second": {:.1f}, "completed": {}}})",
+                              depths.empty() ? "" : ",\n", stats.depth, stats.candidates, stats.hits,
+                              stats.improvements, stats.seconds, ratio(stats.candidates, stats.seconds),
+                              stats.completed);
+    }
+    const double seconds_left = projected_seconds_left_in_depth();
+    const auto& current_depth = depths_.empty() ? DepthStats{} : depths_.back();
+    return fmt::format(R"({{
+  "elapsed_seconds": {:.3f},
+  "candidates": {},
+  "moves_applied": {},
+  "hits": {},
+  "improvements": {},
+  "rotated_hits": {},
+  "rotated_improvements": {},
+  "inverse_hits": {},
+  "inverse_improvements": {},
+  "candidates_per_second": {:.1f},
+  "moves_applied_per_second": {:.1f},
+  "recent_candidates_per_second": {:.1f},
+  "recent_moves_applied_per_second": {:.1f},
+  "hit_rate": {:.9f},
+  "improvement_rate": {:.6f},
+  "improvements_per_second": {:.3f},
+  "recent_improvements_per_second": {:.3f},
+  "patterns_found": {},
+  "patterns_total": {},
+  "current_depth": {{"depth": {}, "progress": {:.6f}, "elapsed_seconds": {:.3f}, "projected_seconds_left": {}}},
+  "depths": [
+{}
+  ]
+}}
+)",
+        elapsed, candidates_, moves_applied_, hits_, improvements_,
+        rotated_hits_, rotated_improvements_, inverse_hits_, inverse_improvements_,
+        ratio(candidates_, elapsed), ratio(moves_applied_, elapsed),
+        ratio(recent_.candidates, recent_seconds_), ratio(recent_.moves_applied, recent_seconds_),
+        ratio(hits_, candidates_), ratio(improvements_, hits_),
+        ratio(improvements_, elapsed), ratio(recent_.improvements, recent_seconds_),
+        num_patterns_found_, num_patterns_total_,
+        current_depth.depth, depth_progress_, current_depth.seconds,
+        seconds_left < 0 ? std::string("null") : fmt::format("{:.1f}", seconds_left),
+        depths);
+}
+
+/// @returns e.g. "3h 12m", "12m 5s" or "42s"
+static std::string format_duration(double seconds) {
+    const auto s = uint64_t(seconds);
+    if (s >= 3600) {
+        return fmt::format("{}h {}m", s / 3600, s % 3600 / 60);
+    }
+    if (s >= 60) {
+        return fmt::format("{}m {}s", s / 60, s % 60);
+    }
+    return fmt::format("{}s", s);
+}
+
+std::string FinderTelemetry::summary() const {
+    const double seconds_left = projected_seconds_left_in_depth();
+    return fmt::format("{:.2f}M candidates/s, {} moves {:.2f}%, ETA {}",
+                       ratio(recent_.candidates, recent_seconds_) / 1e6,
+                       depths_.empty() ? 0 : depths_.back().depth, depth_progress_ * 100.,
+                       seconds_left < 0 ? "unknown" : format_duration(seconds_left));
+}
+
+bool FinderTelemetry::save_to_file(const std::string& path) const {
+    const auto tmp_path = path + ".tmp";
+    if (!saveToFile(tmp_path, to_json())) {
+        return false;
+    }
+    std::error_code error;
+    std::filesystem::rename(tmp_path, path, error);
+    return !error;
+}
+
+} // namespace cubing
@@ -0,0 +1,97 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cubing {
+
+/// Throughput of a brute-force alg search: candidates and moves applied per second, predicate hit rate, improvement
+/// rate and time per depth (alg size), with the projected time left for the current depth. Counting is cheap enough
+/// for the hot loop; everything else is computed when the stats are reported.
+/// "hits", "hit_rate" and "improvements" only count candidates matching the predicate themselves, at most one hit per
+/// candidate. Hits found by looking at a candidate from a rotated cube or at its inverse alg are reported separately as
+/// "rotated_hits"/"rotated_improvements" and "inverse_hits"/"inverse_improvements".
+class FinderTelemetry {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit FinderTelemetry(Clock::time_point start = Clock::now());
+
+    /// a candidate alg of @param num_moves moves was checked
+    void on_candidate(size_t num_moves) {
+        ++candidates_;
+        moves_applied_ += num_moves;
+    }
+    /// where a hit comes from: the candidate itself, the candidate on a rotated cube, or its inverse alg (on any cube)
+    enum class HitSource : uint8_t {candidate, rotated, inverse};
+    /// a predicate matched; @param improved is true if the alg was stored
+    void on_hit(bool improved, HitSource source = HitSource::candidate) {
+        switch (source) {
+            case HitSource::candidate:
+                ++hits_;
+                improvements_ += improved;
+                break;
+            case HitSource::rotated:
+                ++rotated_hits_;
+                rotated_improvements_ += improved;
+                break;
+            case HitSource::inverse:
+                ++inverse_hits_;
+                inverse_improvements_ += improved;
+                break;
+        }
+    }
+
+    /// records the search position: alg size @param depth and progress within it (see
+    /// IterativeScramble::progress_fraction()). When the depth changes, the previous one is closed.
+    void update(size_t depth, double depth_progress, size_t num_patterns_found, size_t num_patterns_total,
+                Clock::time_point now = Clock::now());
+
+    /// @returns stats as of the last update() as a JSON object
+    std::string to_json() const;
+    /// @returns one-line human readable summary, e.g. "1.2M candidates/s, 5 moves 42.1%, ETA 3m"
+    std::string summary() const;
+    /// writes to_json() to a temporary file and renames it to @param path, so readers never see a partial file
+    [[nodiscard]] bool save_to_file(const std::string& path) const;
+
+    struct DepthStats {
+        size_t depth{0};
+        uint64_t candidates{0};
+        uint64_t hits{0};
+        uint64_t improvements{0};
+        double seconds{0};
+        bool completed{false};
+    };
+    const std::vector<DepthStats>& depths() const {return depths_;}
+    /// @returns estimated seconds until the current depth is done, negative if unknown
+    double projected_seconds_left_in_depth() const;
+
+private:
+    struct Totals {
+        uint64_t candidates{0}, moves_applied{0}, hits{0}, improvements{0};
+    };
+    Totals totals() const {return {candidates_, moves_applied_, hits_, improvements_};}
+
+    uint64_t candidates_{0};
+    uint64_t moves_applied_{0};
+    uint64_t hits_{0};
+    uint64_t improvements_{0};
+    uint64_t rotated_hits_{0}, rotated_improvements_{0};
+    uint64_t inverse_hits_{0}, inverse_improvements_{0};
+
+    Clock::time_point start_;
+    Clock::time_point depth_start_;
+    Totals depth_start_totals_;
+    Clock::time_point last_update_;
+    Totals last_update_totals_;
+    double recent_seconds_{0};
+    Totals recent_; // since the update before the last one
+
+    double depth_progress_{0};
+    size_t num_patterns_found_{0};
+    size_t num_patterns_total_{0};
+    std::vector<DepthStats> depths_; // the last one is the current depth
+};
+
+} // namespace cubing
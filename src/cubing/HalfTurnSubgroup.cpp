@@ -0,0 +1,75 @@
+#include "HalfTurnSubgroup.h"
+#include <stdexcept>
+#include <unordered_set>
+
+namespace cubing {
+
+static constexpr size_t kMaxLength = 64 / 3;
+static constexpr uint8_t kHalfTurnOffset = uint8_t(sides333) * uint8_t(directionDouble); // half turn = face + offset
+
+/// @returns Lehmer code of the permutation of cubies given by the first sticker of each position of @param stickers
+static uint64_t cubies_rank(const uint8_t* stickers, size_t num_cubies, size_t stickers_per_cubie) {
+    uint64_t rank = 0;
+    for (size_t i = 0; i < num_cubies; ++i) {
+        const size_t cubie = stickers[i * stickers_per_cubie] / stickers_per_cubie;
+        size_t num_smaller_after = 0;
+        for (size_t j = i + 1; j < num_cubies; ++j) {
+            num_smaller_after += stickers[j * stickers_per_cubie] / stickers_per_cubie < cubie;
+        }
+        rank = rank * (num_cubies - i) + num_smaller_after;
+    }
+    return rank;
+}
+
+/// @returns key of a permutation of the subgroup: ranks of its corner (8! < 2^16) and edge (12! < 2^29) permutations
+static uint64_t state_key(const CubeState<sides333>& permutation) {
+    const auto corners = cubies_rank(permutation.stickerColors(CubeState<sides333>::cornerStickers), 8, 3);
+    const auto edges = cubies_rank(permutation.stickerColors(CubeState<sides333>::edgeStickers), 12, 2);
+    return edges << 16 | corners;
+}
+
+const HalfTurnSubgroup& HalfTurnSubgroup::instance() {
+    static const HalfTurnSubgroup subgroup;
+    return subgroup;
+}
+
+HalfTurnSubgroup::HalfTurnSubgroup() {
+    permutations_.reserve(NUM_STATES);
+    packed_moves_.reserve(NUM_STATES);
+    lengths_.reserve(NUM_STATES);
+    std::unordered_set<uint64_t> visited;
+    visited.reserve(NUM_STATES);
+
+    permutations_.push_back(CubeState<sides333>::identityPermutation());
+    packed_moves_.push_back(0);
+    lengths_.push_back(0);
+    visited.insert(state_key(permutations_.front()));
+    // the vector is the BFS queue
+    for (size_t i = 0; i < permutations_.size(); ++i) {
+        const size_t length = lengths_[i];
+        for (uint8_t face = 0; face < sides333; ++face) {
+            auto next = permutations_[i];
+            next.applyScrambleMove(face + kHalfTurnOffset);
+            if (!visited.insert(state_key(next)).second) {
+                continue;
+            }
+            if (length + 1 > kMaxLength) {
+                throw std::logic_error("HalfTurnSubgroup: sequence too long to pack");
+            }
+            permutations_.push_back(next);
+            packed_moves_.push_back(packed_moves_[i] | uint64_t(face) << (3 * length));
+            lengths_.push_back(uint8_t(length + 1));
+        }
+    }
+}
+
+MovesVector<sides333> HalfTurnSubgroup::moves(size_t i) const {
+    MovesVector<sides333> result;
+    result.reserve(lengths_[i]);
+    for (size_t j = 0; j < lengths_[i]; ++j) {
+        result.push_back(uint8_t((packed_moves_[i] >> (3 * j) & 7) + kHalfTurnOffset));
+    }
+    return result.canonicalized(); // same length, since it's a shortest one
+}
+
+} // namespace cubing
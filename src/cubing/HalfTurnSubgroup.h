@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "CubingDefs.h"
+#include "CubeState.h"
+#include "MovesVector.h"
+
+namespace cubing {
+
+/*
+ * All states of the <R2, L2, U2, D2, F2, B2> subgroup, each with a shortest canonical sequence of half turns and its
+ * compiled permutation. States are in BFS order, so state 0 is the identity and sequences never get shorter.
+ *
+ * Half turns keep all orientations, so the BFS tells states apart by their corner and edge permutations only. The table
+ * takes about 90MB and a second to build, so it's built once on first use.
+ */
+class HalfTurnSubgroup {
+public:
+    static constexpr size_t NUM_STATES = 663'552;
+
+    static const HalfTurnSubgroup& instance();
+
+    size_t size() const {return permutations_.size();}
+    size_t length(size_t i) const {return lengths_[i];}
+    /// @returns shortest sequence for state @param i, e.g. <R2 L2 U2>
+    MovesVector<sides333> moves(size_t i) const;
+    /// @returns state @param i as a permutation, see CubeState::compileAlgorithm
+    const CubeState<sides333>& permutation(size_t i) const {return permutations_[i];}
+
+private:
+    HalfTurnSubgroup();
+
+    std::vector<CubeState<sides333>> permutations_;
+    std::vector<uint64_t> packed_moves_; // 3 bits per move: face index of the half turn, first move in the lowest bits
+    std::vector<uint8_t> lengths_;
+};
+
+} // namespace cubing
@@ -0,0 +1,127 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace cubing {
+
+/// Vector of trivially copyable elements that keeps up to InlineCapacity elements inside the object and only
+/// allocates when it grows past that. Copying an inline vector is a plain memcpy.
+template<class T, size_t InlineCapacity>
+class InlineVector {
+    static_assert(std::is_trivially_copyable_v<T>, "InlineVector only supports trivially copyable elements");
+public:
+    InlineVector() = default;
+    InlineVector(const InlineVector& other) {copy_from(other);}
+    InlineVector(InlineVector&& other) noexcept {move_from(std::move(other));}
+    InlineVector& operator=(const InlineVector& other) {
+        if (this != &other) {
+            free_heap();
+            copy_from(other);
+        }
+        return *this;
+    }
+    InlineVector& operator=(InlineVector&& other) noexcept {
+        if (this != &other) {
+            free_heap();
+            move_from(std::move(other));
+        }
+        return *this;
+    }
+    ~InlineVector() {free_heap();}
+
+    size_t size() const {return size_;}
+    size_t capacity() const {return capacity_;}
+    bool empty() const {return size_ == 0;}
+    bool is_inline() const {return capacity_ == InlineCapacity;}
+    void clear() {size_ = 0;}
+
+    void reserve(size_t capacity) {
+        if (capacity > capacity_) {
+            grow_to(capacity);
+        }
+    }
+    /// new elements are zero-initialized
+    void resize(size_t size) {
+        reserve(size);
+        if (size > size_) {
+            std::memset(data() + size_, 0, (size - size_) * sizeof(T));
+        }
+        size_ = size;
+    }
+    void push_back(const T& value) {
+        if (size_ == capacity_) {
+            grow_to(capacity_ * 2);
+        }
+        data()[size_++] = value;
+    }
+    void pop_back() {--size_;}
+
+    T* data() {return is_inline() ? inline_ : heap_;}
+    const T* data() const {return is_inline() ? inline_ : heap_;}
+    T& operator[](size_t i) {return data()[i];}
+    const T& operator[](size_t i) const {return data()[i];}
+    T& front() {return data()[0];}
+    const T& front() const {return data()[0];}
+    T& back() {return data()[size_ - 1];}
+    const T& back() const {return data()[size_ - 1];}
+
+    T* begin() {return data();}
+    T* end() {return data() + size_;}
+    const T* begin() const {return data();}
+    const T* end() const {return data() + size_;}
+    auto rbegin() const {return std::make_reverse_iterator(end());}
+    auto rend() const {return std::make_reverse_iterator(begin());}
+
+    bool operator==(const InlineVector& other) const {
+        return size_ == other.size_ && std::memcmp(data(), other.data(), size_ * sizeof(T)) == 0;
+    }
+
+private:
+    void grow_to(size_t capacity) {
+        T* heap = new T[capacity];
+        std::memcpy(heap, data(), size_ * sizeof(T));
+        free_heap();
+        heap_ = heap;
+        capacity_ = capacity;
+    }
+    void free_heap() {
+        if (!is_inline()) {
+            delete[] heap_;
+            capacity_ = InlineCapacity;
+        }
+    }
+    void copy_from(const InlineVector& other) {
+        size_ = other.size_;
+        if (other.size_ <= InlineCapacity) {
+            capacity_ = InlineCapacity;
+            std::memcpy(inline_, other.data(), size_ * sizeof(T));
+        } else {
+            capacity_ = other.size_;
+            heap_ = new T[capacity_];
+            std::memcpy(heap_, other.heap_, size_ * sizeof(T));
+        }
+    }
+    void move_from(InlineVector&& other) {
+        size_ = other.size_;
+        capacity_ = other.capacity_;
+        if (other.is_inline()) {
+            std::memcpy(inline_, other.inline_, size_ * sizeof(T));
+        } else {
+            heap_ = other.heap_;
+            other.capacity_ = InlineCapacity;
+        }
+        other.size_ = 0;
+    }
+
+    uint32_t size_{0};
+    uint32_t capacity_{InlineCapacity};
+    union {
+        T inline_[InlineCapacity];
+        T* heap_;
+    };
+};
+
+} // namespace cubing
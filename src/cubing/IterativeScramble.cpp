@@ -1,10 +1,13 @@
 #include "IterativeScramble.h"
+#include "Counters.h"
+#include <algorithm>
 #include <sstream>
 
 namespace cubing {
 
 template<QtmMoveSetSize qtmMoveSetSize>
 IterativeScramble<qtmMoveSetSize>& IterativeScramble<qtmMoveSetSize>::operator++() {
+    CUBING_COUNT(scrambleIncrements);
     if (moves_.empty()) {
         moves_.push_back(0);
         return *this;
@@ -26,10 +29,16 @@ IterativeScramble<qtmMoveSetSize>& IterativeScramble<qtmMoveSetSize>::operator++
 
     incrementStartingFrom(0);
 
-    // disallow scrambles like <R M' R> or <R' R2> by discarding subsequences of parallel moves that are not sorted.
+    // disallow scrambles like <R M' R>, <R' R2> or <L R> by discarding subsequences of parallel moves that are not
+    // strictly sorted by layer, same as MovesVector::canonicalized() does
     for (size_t j = 0; j < moves_.size() - 1; ++j) {
         if (CubeTraits<qtmMoveSetSize>::are_parallel_layer_moves(moves_[j], moves_[j + 1])
-            && moves_[j] >= moves_[j + 1]) {
+            && moves_[j] % qtmMoveSetSize >= moves_[j + 1] % qtmMoveSetSize) {
+            CUBING_COUNT(canonicalRejections);
+            CUBING_COUNT_N(canonicalRescans, j);
+            // the earlier moves are less significant, so the next candidate has them reset; otherwise canonical
+            // algs like <R U R> would be skipped
+            std::fill(moves_.begin(), moves_.begin() + j, 0);
             incrementStartingFrom(j);
             j = -1; // reset
         }
@@ -55,6 +64,17 @@ std::string IterativeScramble<qtmMoveSetSize>::progress() const {
     return result;
 }
 
+template<QtmMoveSetSize qtmMoveSetSize>
+double IterativeScramble<qtmMoveSetSize>::progress_fraction() const {
+    // moves_ is a number in base numHtmMoves with the last move being the most significant digit
+    const double numHtmMoves = qtmMoveSetSize * 3;
+    double fraction = 0;
+    for (const auto move : moves_) {
+        fraction = (fraction + move) / numHtmMoves;
+    }
+    return fraction;
+}
+
 template<QtmMoveSetSize qtmMoveSetSize>
 IterativeScramble<qtmMoveSetSize> IterativeScramble<qtmMoveSetSize>::from_moves(const MovesVector<qtmMoveSetSize>& m) {
     IterativeScramble<qtmMoveSetSize> result;
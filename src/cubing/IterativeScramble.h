@@ -9,12 +9,16 @@ namespace cubing {
 template<QtmMoveSetSize qtmMoveSetSize>
 class IterativeScramble {
 public:
-    // Next algorithm. Skips algs like <R R2>. Also skips <M' R L'> and <L' R M'> but not <R L' M'> (ascending move indexes)
+    // Next algorithm. Skips algs like <R R2>. Also skips <M' R L'> and <L' R M'> but not <R L' M'> (ascending layers)
     IterativeScramble& operator++();
 
     /// \returns progress report (percent, num moves etc.)
     std::string progress() const;
 
+    /// \returns share of algs of the current size that were already iterated through, in [0, 1). Skipped algs count as
+    /// iterated, so the fraction grows unevenly but never goes back.
+    double progress_fraction() const;
+
     /// \returns current scramble
     const MovesVector<qtmMoveSetSize>& get() const {return moves_;}
 
@@ -0,0 +1,119 @@
+#include "MirrorScrambles.h"
+#include <array>
+
+namespace cubing {
+
+namespace {
+
+enum class LetterKind : uint8_t {
+    none,        // not a move letter
+    swappedFace, // R <-> L for lr; prefix and 'w' allowed
+    swappedInner,// r <-> l for lr; only bare
+    keptIfBare,  // x, M, m for lr: bare moves keep their direction
+    inverted,    // all the other move letters
+};
+
+struct MirrorTable {
+    std::array<LetterKind, 128> kinds{};
+    std::array<char, 128> swapped{};
+};
+
+constexpr MirrorTable make_mirror_table(std::string_view faces, std::string_view inner, std::string_view kept) {
+    MirrorTable table;
+    for (const char c : std::string_view("UFDBLRufdblrSMEsmexyz")) {
+        table.kinds[c] = LetterKind::inverted;
+    }
+    for (const char c : kept) {
+        table.kinds[c] = LetterKind::keptIfBare;
+    }
+    table.kinds[faces[0]] = table.kinds[faces[1]] = LetterKind::swappedFace;
+    table.kinds[inner[0]] = table.kinds[inner[1]] = LetterKind::swappedInner;
+    table.swapped[faces[0]] = faces[1];
+    table.swapped[faces[1]] = faces[0];
+    table.swapped[inner[0]] = inner[1];
+    table.swapped[inner[1]] = inner[0];
+    return table;
+}
+
+constexpr std::array<MirrorTable, 3> kMirrorTables = {
+    make_mirror_table("RL", "rl", "xmM"),
+    make_mirror_table("UD", "ud", "yEe"),
+    make_mirror_table("FB", "fb", "Ssz"),
+};
+
+/// @returns true if the mirrored move is the same as the original one
+constexpr bool is_kept_as_is(LetterKind kind, bool bare, char suffix) {
+    switch (kind) {
+        case LetterKind::swappedFace: return false;
+        case LetterKind::swappedInner: return !bare; // 3r, rw etc. aren't mirrored
+        case LetterKind::keptIfBare: return bare || suffix == '2';
+        case LetterKind::inverted: return suffix == '2';
+        default: return true;
+    }
+}
+
+} // namespace
+
+void appendMirroredMove(std::string_view move, MirrorAxis axis, std::string& out) {
+    const auto& table = kMirrorTables[axis];
+    // lex [234]? letter w? ['2]?
+    size_t pos = 0;
+    const bool has_prefix = !move.empty() && move[0] >= '2' && move[0] <= '4';
+    pos += has_prefix;
+    const char letter = pos < move.size() ? move[pos] : '\0';
+    const auto kind = (letter & 0x80) ? LetterKind::none : table.kinds[letter];
+    ++pos;
+    const bool is_wide = pos < move.size() && move[pos] == 'w';
+    pos += is_wide;
+    const char suffix = pos < move.size() ? move[pos] : '\0';
+    const bool valid = kind != LetterKind::none && pos + (suffix != '\0') == move.size()
+                       && (suffix == '\0' || suffix == '\'' || suffix == '2');
+    if (!valid || is_kept_as_is(kind, !has_prefix && !is_wide, suffix)) {
+        out += move;
+        return;
+    }
+    const bool swapped = kind == LetterKind::swappedFace || kind == LetterKind::swappedInner;
+    out += move.substr(0, has_prefix);
+    out.push_back(swapped ? table.swapped[letter] : letter);
+    if (is_wide) {
+        out.push_back('w');
+    }
+    if (suffix == '2') {
+        out.push_back('2');
+    } else if (suffix == '\0') {
+        out.push_back('\'');
+    }
+}
+
+std::string mirrorUfmMove(std::string_view move, MirrorAxis axis) {
+    std::string result;
+    result.reserve(move.size() + 1);
+    appendMirroredMove(move, axis, result);
+    return result;
+}
+
+std::string mirrorUfmAlg(std::string_view alg, MirrorAxis axis) {
+    std::string result;
+    result.reserve(alg.size() + alg.size() / 2);
+    size_t pos = 0;
+    while (pos < alg.size()) {
+        const size_t move_end = std::min(alg.find(' ', pos), alg.size());
+        appendMirroredMove(alg.substr(pos, move_end - pos), axis, result);
+        if (move_end < alg.size()) {
+            result.push_back(' ');
+        }
+        pos = move_end + 1;
+    }
+    return result;
+}
+
+std::vector<std::string> mirrorUfmAlgs(const std::vector<std::string_view>& algs, MirrorAxis axis) {
+    std::vector<std::string> result;
+    result.reserve(algs.size());
+    for (const auto alg : algs) {
+        result.push_back(mirrorUfmAlg(alg, axis));
+    }
+    return result;
+}
+
+} // namespace cubing
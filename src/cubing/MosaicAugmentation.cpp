@@ -0,0 +1,346 @@
+#include "MosaicAugmentation.h"
+#include "FacePatternPredicate.h"
+#include "ScrambleProcessing.h"
+#include "Tracing.h"
+#include <fmt/format.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+namespace cubing {
+
+MovesVector<sides333> apply_symmetry_variant(const MovesVector<sides333>& alg, uint8_t variant) {
+    MovesVector<sides333> result = (variant & variantInverse) ? alg.inverted() : alg;
+    if (variant & variantLeft2Right) {
+        result = result.left2right();
+    }
+    if (variant & variantFront2Back) {
+        result = result.front2back();
+    }
+    return result;
+}
+
+std::string apply_symmetry_variant(const std::string& alg, uint8_t variant) {
+    std::string result = (variant & variantInverse) ? invertScramble(alg) : alg;
+    if (variant & variantLeft2Right) {
+        result = left2right(result);
+    }
+    if (variant & variantFront2Back) {
+        result = front2back(result);
+    }
+    return result;
+}
+
+CompiledAlgVariants CompiledAlgVariants::compile(const std::string& alg) {
+    const auto moves = MovesVector<sides333>::from_string(alg);
+    CompiledAlgVariants result;
+    for (uint8_t variant = 0; variant < NUM_SYMMETRY_VARIANTS; ++variant) {
+        result.moves[variant] = apply_symmetry_variant(moves, variant);
+        result.algs[variant] = (variant == 0) ? alg : result.moves[variant].to_string();
+        // variants come in (v, v | variantInverse) pairs, so inverses reuse the permutation compiled just before
+        result.permutations[variant] = (variant & variantInverse)
+            ? result.permutations[variant ^ variantInverse].inversePermutation()
+            : CubeState<sides333>::compileAlgorithm(result.moves[variant]);
+    }
+    return result;
+}
+
+using Part = MosaicAugmenter::Part;
+
+struct CombinationTemplate {
+    std::vector<Part> parts;
+    bool addon_independent{false}; // only explored once per base alg
+};
+
+static constexpr Part kAlg{Part::base, 0}, kAddon{Part::addon, 0}, kRL{Part::rlSlices, 0}, kUD{Part::udSlices, 0};
+static constexpr Part kAlgInv{Part::base, variantInverse};
+static constexpr Part kAlgL2R{Part::base, variantLeft2Right};
+static constexpr Part kAlgL2RInv{Part::base, variantLeft2Right | variantInverse};
+static constexpr Part kAlgF2BInv{Part::base, variantFront2Back | variantInverse};
+
+// every template is explored in all symmetry variants
+static const std::vector<CombinationTemplate> kCombinationTemplates = {
+    {{kAlg}, true},
+
+    {{kAlg, kAddon}},
+    {{kAddon, kAlg}},
+    {{kAddon, kAlg, kAddon}},
+
+    // transform the alg independently
+    {{kAlgInv, kAddon}},
+    {{kAlgL2R, kAddon}},
+    {{kAlgL2RInv, kAddon}},
+
+    {{kAddon, kAlgInv}},
+    {{kAddon, kAlgL2R}},
+    {{kAddon, kAlgL2RInv}},
+
+    {{kAddon, kAlgInv, kAddon}},
+    {{kAddon, kAlgL2R, kAddon}},
+    {{kAddon, kAlgL2RInv, kAddon}},
+
+    // most random stuff
+    {{kAlg, kAlg}, true},
+    {{kAlg, kAlgL2RInv}, true},
+    {{kAlg, kAlgF2BInv}, true},
+
+    // misc
+    {{kAddon, kRL, kAlg}},
+    {{kAddon, kUD, kAlg}},
+    {{kRL, kAddon, kAlg}},
+    {{kUD, kAddon, kAlg}},
+    {{kAddon, kAlg, kRL}},
+    {{kAddon, kAlg, kUD}},
+    {{kAddon, kRL, kAlg, kAddon}},
+    {{kAddon, kUD, kAlg, kAddon}},
+};
+
+MosaicAugmenter::MosaicAugmenter(const std::vector<std::string>& addon_algs, bool half_turn_subgroup_addons,
+                                 size_t half_turn_subgroup_step) :
+    rl_slices_(CompiledAlgVariants::compile("R2 L2")),
+    ud_slices_(CompiledAlgVariants::compile("U2 D2")),
+    half_turn_subgroup_(half_turn_subgroup_addons ? &HalfTurnSubgroup::instance() : nullptr),
+    half_turn_subgroup_step_(std::max<size_t>(half_turn_subgroup_step, 1)) {
+    addons_.reserve(addon_algs.size());
+    for (const auto& addon : addon_algs) {
+        addons_.push_back(CompiledAlgVariants::compile(addon));
+    }
+}
+
+void MosaicAugmenter::explore(const std::string& alg, PatternToAlgMap& found, const PatternToAlgMap& known) {
+    const auto base = CompiledAlgVariants::compile(alg);
+    for (size_t addon_index = 0; addon_index < addons_.size(); ++addon_index) {
+        for (const auto& combination : kCombinationTemplates) {
+            if (combination.addon_independent && addon_index != 0) {
+                continue; // same strings as for the first addon
+            }
+            explore_combination(combination.parts, base, addons_[addon_index], found, known);
+        }
+    }
+    if (half_turn_subgroup_) {
+        explore_half_turn_subgroup(base, found, known);
+    }
+}
+
+/// adds canonicalized @param moves to @param found, unless @param known has an alg for @param pattern that isn't longer
+static void record_hit(const MovesVector<sides333>& moves, const std::string& pattern, PatternToAlgMap& found,
+                       const PatternToAlgMap& known) {
+    const auto alg = moves.canonicalized().to_string();
+    if (const auto itr = known.get().find(pattern); itr != known.get().end() && itr->second.size() <= alg.size()) {
+        return;
+    }
+    found.insert_if_preferred(pattern, alg);
+}
+
+void MosaicAugmenter::explore_combination(const std::vector<Part>& parts, const CompiledAlgVariants& base,
+                                          const CompiledAlgVariants& addon, PatternToAlgMap& found,
+                                          const PatternToAlgMap& known) {
+    const auto source = [&](const Part& part) -> const CompiledAlgVariants& {
+        switch (part.source) {
+            case Part::base: return base;
+            case Part::addon: return addon;
+            case Part::rlSlices: return rl_slices_;
+            default: return ud_slices_;
+        }
+    };
+    const size_t num_parts = parts.size();
+    for (uint8_t variant = 0; variant < NUM_SYMMETRY_VARIANTS; ++variant) {
+        // inverse of <A B> is <B' A'>, mirrors keep the order
+        const bool reversed = variant & variantInverse;
+        const auto part_at = [&](size_t i) -> std::pair<const CompiledAlgVariants&, uint8_t> {
+            const auto& part = parts[reversed ? num_parts - 1 - i : i];
+            return {source(part), uint8_t(variant ^ part.variant)};
+        };
+
+        CubeState<sides333> cube;
+        for (size_t i = 0; i < num_parts; ++i) {
+            const auto [compiled, part_variant] = part_at(i);
+            cube.applyPermutation(compiled.permutations[part_variant]);
+        }
+        ++num_combinations_checked_;
+        if (!cube.doFrontAndBackSidesHaveSamePatternWithOppositeColors()) {
+            continue;
+        }
+
+        MovesVector<sides333> moves;
+        for (size_t i = 0; i < num_parts; ++i) {
+            const auto [compiled, part_variant] = part_at(i);
+            for (const auto move : compiled.moves[part_variant]) {
+                moves.push_back(move);
+            }
+        }
+        record_hit(moves, cube.frontSideStickers(), found, known);
+    }
+}
+
+void MosaicAugmenter::explore_half_turn_subgroup(const CompiledAlgVariants& base, PatternToAlgMap& found,
+                                                 const PatternToAlgMap& known) {
+    using Orbit = CubeState<sides333>::StickerOrbit;
+    static const auto mosaic = FacePatternPredicate<sides333>::compile(TWO_SIDED_MOSAIC_PREDICATE);
+    const CubeState<sides333> solved;
+    const auto& subgroup = *half_turn_subgroup_;
+    for (uint8_t variant = 0; variant < NUM_SYMMETRY_VARIANTS; ++variant) {
+        const auto& alg = base.permutations[variant];
+        for (size_t i = 0; i < subgroup.size(); i += half_turn_subgroup_step_) {
+            const auto& element = subgroup.permutation(i);
+            for (const bool as_prefix : {false, true}) {
+                const auto& first = as_prefix ? element : alg;
+                const auto& second = as_prefix ? alg : element;
+                // only the F and B stickers of <first second> are composed: color of s is solved[first[second[s]]]
+                const auto color = [&](const FaceSticker& sticker) {
+                    const auto orbit = Orbit(sticker.orbit);
+                    return solved.stickerColors(orbit)[first.stickerColors(orbit)[second.stickerColors(orbit)[sticker.index]]];
+                };
+                ++num_combinations_checked_;
+                bool is_mosaic = true;
+                for (const auto& check : mosaic.checks()) {
+                    if (check.expected[color(check.lhs)] != color(check.rhs)) {
+                        is_mosaic = false;
+                        break;
+                    }
+                }
+                if (!is_mosaic) {
+                    continue;
+                }
+                MovesVector<sides333> moves;
+                for (const auto& part : {as_prefix ? subgroup.moves(i) : base.moves[variant],
+                                         as_prefix ? base.moves[variant] : subgroup.moves(i)}) {
+                    for (const auto move : part) {
+                        moves.push_back(move);
+                    }
+                }
+                CubeState<sides333> cube;
+                cube.applyPermutation(first);
+                cube.applyPermutation(second);
+                record_hit(moves, cube.frontSideStickers(), found, known);
+            }
+        }
+    }
+}
+
+PatternToAlgMap augment_in_parallel(const PatternToAlgMap& map, const std::vector<std::string>& algs_to_explore,
+                                    const MosaicAugmenter& augmenter, const ParallelAugmentationOptions& options,
+                                    const std::function<void(const PatternToAlgMap&, const AugmentationProgress&)>& on_progress) {
+    CUBING_TRACE_SPAN("augment");
+    const size_t num_threads = std::max<size_t>(1, options.num_threads);
+    const size_t batch_size = std::max<size_t>(1, options.algs_per_batch);
+    std::atomic<size_t> next_alg{0};
+
+    // shared with workers, guarded by mutex
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<PatternToAlgMap> pending_maps;
+    AugmentationProgress progress{.num_algs_total = algs_to_explore.size()};
+    size_t num_workers_running = num_threads;
+    std::exception_ptr error;
+
+    const auto worker = [&](size_t worker_index) {
+        set_trace_thread_name(fmt::format("worker {}", worker_index));
+        CUBING_TRACE_SPAN("worker");
+        MosaicAugmenter local_augmenter = augmenter;
+        try {
+            for (size_t begin = next_alg.fetch_add(batch_size); begin < algs_to_explore.size();
+                 begin = next_alg.fetch_add(batch_size)) {
+                const size_t end = std::min(begin + batch_size, algs_to_explore.size());
+                const auto combinations_before = local_augmenter.num_combinations_checked();
+                PatternToAlgMap found;
+                CUBING_TRACE_SPAN("explore");
+                for (size_t i = begin; i < end; ++i) {
+                    if (!algs_to_explore[i].empty()) {
+                        local_augmenter.explore(algs_to_explore[i], found, map);
+                    }
+                }
+                std::lock_guard lock(mutex);
+                pending_maps.push_back(std::move(found));
+                progress.num_algs_checked += end - begin;
+                progress.num_combinations_checked += local_augmenter.num_combinations_checked() - combinations_before;
+                cv.notify_one();
+            }
+        } catch (...) {
+            std::lock_guard lock(mutex);
+            error = std::current_exception();
+            next_alg = algs_to_explore.size(); // stop other workers
+        }
+        std::lock_guard lock(mutex);
+        --num_workers_running;
+        cv.notify_one();
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        threads.emplace_back(worker, i);
+    }
+
+    PatternToAlgMap merged = map;
+    auto last_progress_reported = std::chrono::steady_clock::now();
+    for (bool done = false; !done; ) {
+        std::vector<PatternToAlgMap> maps_to_merge;
+        AugmentationProgress current_progress;
+        {
+            std::unique_lock lock(mutex);
+            cv.wait_for(lock, options.progress_interval,
+                        [&] {return !pending_maps.empty() || num_workers_running == 0;});
+            std::swap(maps_to_merge, pending_maps);
+            done = num_workers_running == 0;
+            current_progress = progress;
+        }
+        for (const auto& found : maps_to_merge) {
+            merged.merge(found);
+        }
+        if (options.stop_at_map_size > 0 && merged.size() >= options.stop_at_map_size) {
+            next_alg = algs_to_explore.size(); // workers stop after their current batch
+        }
+        const auto now = std::chrono::steady_clock::now();
+        if (done || now - last_progress_reported >= options.progress_interval) {
+            last_progress_reported = now;
+            current_progress.done = done && !error;
+            if (!error) {
+                on_progress(merged, current_progress);
+            }
+        }
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    return merged;
+}
+
+PatternToAlgMap augment_until_fixpoint(const PatternToAlgMap& map, const MosaicAugmenter& augmenter,
+                                       const ParallelAugmentationOptions& options, size_t max_rounds,
+                                       const std::function<void(const PatternToAlgMap&, const AugmentationProgress&)>& on_progress,
+                                       const std::function<void(const PatternToAlgMap&, const AugmentationRound&)>& on_round_done) {
+    PatternToAlgMap current = map;
+    std::vector<std::string> frontier;
+    frontier.reserve(map.size());
+    for (const auto& [pattern, alg] : map.get()) {
+        frontier.push_back(alg);
+    }
+    const auto complete = [&] {return options.stop_at_map_size > 0 && current.size() >= options.stop_at_map_size;};
+    for (size_t round = 1; round <= max_rounds && !frontier.empty() && !complete(); ++round) {
+        TraceSpan round_span(fmt::format("round {}", round));
+        auto augmented = augment_in_parallel(current, frontier, augmenter, options, on_progress);
+        AugmentationRound report{.round = round, .num_algs_explored = frontier.size(), .map_size = augmented.size()};
+        frontier.clear();
+        for (const auto& [pattern, alg] : augmented.get()) {
+            const auto itr = current.get().find(pattern);
+            if (itr == current.get().end()) {
+                ++report.num_new_patterns;
+            } else if (itr->second != alg) {
+                ++report.num_improved_algs;
+            } else {
+                continue;
+            }
+            frontier.push_back(alg);
+        }
+        current = std::move(augmented);
+        on_round_done(current, report);
+    }
+    return current;
+}
+
+} // namespace cubing
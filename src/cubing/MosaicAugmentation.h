@@ -0,0 +1,116 @@
+#pragma once
+#include <array>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <functional>
+#include "CubeState.h"
+#include "HalfTurnSubgroup.h"
+#include "MosaicDefs.h"
+#include "MovesVector.h"
+
+namespace cubing {
+
+/// Symmetry variant of an alg is a combination of these bits, e.g. (variantInverse | variantLeft2Right) is
+/// left2right(invertScramble(alg)). All of them commute, and variant(A B) == variant(A) variant(B) for mirrors,
+/// so variants of combined algs can be assembled from variants of their parts.
+enum SymmetryVariant : uint8_t {
+    variantInverse = 1,
+    variantLeft2Right = 2,
+    variantFront2Back = 4,
+};
+static constexpr size_t NUM_SYMMETRY_VARIANTS = 8;
+
+/// @returns @param alg transformed with @param variant bits
+MovesVector<sides333> apply_symmetry_variant(const MovesVector<sides333>& alg, uint8_t variant);
+std::string apply_symmetry_variant(const std::string& alg, uint8_t variant);
+
+/// Alg with all of its symmetry variants precomputed, both as strings and as compiled permutations
+struct CompiledAlgVariants {
+    std::array<MovesVector<sides333>, NUM_SYMMETRY_VARIANTS> moves;
+    std::array<std::string, NUM_SYMMETRY_VARIANTS> algs;
+    std::array<CubeState<sides333>, NUM_SYMMETRY_VARIANTS> permutations;
+
+    static CompiledAlgVariants compile(const std::string& alg);
+};
+
+/// Explores combinations of known two-sided mosaic algs with addon algs, e.g. <addon alg addon>, and their symmetry
+/// variants. Combinations are evaluated by composing precompiled permutations; moves of hits are canonicalized, so
+/// cancellations between the parts (<R U> + <U' L> = <R L>) don't inflate stored algs.
+/// With @param half_turn_subgroup_addons, every state of HalfTurnSubgroup is tried as a prefix and as a suffix of every
+/// symmetry variant as well, which takes about 10M checks per alg. With @param half_turn_subgroup_step > 1, only every
+/// step-th state is tried, e.g. for quick runs with two_sided_mosaic_augmentation --half-turn-subgroup-step=N.
+class MosaicAugmenter {
+public:
+    explicit MosaicAugmenter(const std::vector<std::string>& addon_algs, bool half_turn_subgroup_addons = false,
+                             size_t half_turn_subgroup_step = 1);
+
+    /// checks all combinations of @param alg with addons and adds found patterns to @param found with
+    /// insert_if_preferred, unless @param known already has an alg of the same size or shorter for the pattern
+    void explore(const std::string& alg, PatternToAlgMap& found, const PatternToAlgMap& known);
+    void explore(const std::string& alg, PatternToAlgMap& map) {explore(alg, map, map);}
+
+    /// @returns number of combined algs (including symmetry variants) evaluated so far
+    uint64_t num_combinations_checked() const {return num_combinations_checked_;}
+
+    /// alg part of a combination template: which alg and which of its symmetry variants
+    struct Part {
+        enum Source : uint8_t {base, addon, rlSlices, udSlices} source;
+        uint8_t variant;
+    };
+
+private:
+    void explore_combination(const std::vector<Part>& parts, const CompiledAlgVariants& base,
+                             const CompiledAlgVariants& addon, PatternToAlgMap& found, const PatternToAlgMap& known);
+    void explore_half_turn_subgroup(const CompiledAlgVariants& base, PatternToAlgMap& found,
+                                    const PatternToAlgMap& known);
+
+    std::vector<CompiledAlgVariants> addons_;
+    CompiledAlgVariants rl_slices_, ud_slices_;
+    const HalfTurnSubgroup* half_turn_subgroup_{nullptr};
+    size_t half_turn_subgroup_step_{1};
+    uint64_t num_combinations_checked_{0};
+};
+
+struct AugmentationProgress {
+    size_t num_algs_checked{0};
+    size_t num_algs_total{0};
+    uint64_t num_combinations_checked{0};
+    bool done{false};
+};
+
+struct ParallelAugmentationOptions {
+    size_t num_threads{1};
+    size_t algs_per_batch{100}; // workers hand over their partial maps after each batch
+    std::chrono::milliseconds progress_interval{1000};
+    size_t stop_at_map_size{0}; // stop once the merged map has that many patterns, e.g. all reachable ones; 0 = never
+};
+
+/// Explores @param algs_to_explore on worker threads, each with its own map of found algs. Partial maps are merged
+/// into a copy of @param map on the calling thread with insert_if_preferred, so the result doesn't depend on the
+/// scheduling. @param on_progress is called on the calling thread as well (e.g. to save the merged map), at most once
+/// per progress_interval and once when done; workers keep exploring meanwhile.
+/// @returns merged map
+PatternToAlgMap augment_in_parallel(const PatternToAlgMap& map, const std::vector<std::string>& algs_to_explore,
+                                    const MosaicAugmenter& augmenter, const ParallelAugmentationOptions& options,
+                                    const std::function<void(const PatternToAlgMap&, const AugmentationProgress&)>& on_progress);
+
+struct AugmentationRound {
+    size_t round{0}; // 1-based
+    size_t num_algs_explored{0}; // frontier size
+    size_t num_new_patterns{0};
+    size_t num_improved_algs{0}; // patterns that got shorter algs
+    size_t map_size{0};
+};
+
+/// Repeats augment_in_parallel, each round exploring only the frontier: algs that were added or improved by the
+/// previous round (the first round explores all of @param map). Stops when a round doesn't change the map, after
+/// @param max_rounds rounds or when the map reaches options.stop_at_map_size. @param on_round_done is called on the
+/// calling thread after each round.
+/// @returns augmented map
+PatternToAlgMap augment_until_fixpoint(const PatternToAlgMap& map, const MosaicAugmenter& augmenter,
+                                       const ParallelAugmentationOptions& options, size_t max_rounds,
+                                       const std::function<void(const PatternToAlgMap&, const AugmentationProgress&)>& on_progress,
+                                       const std::function<void(const PatternToAlgMap&, const AugmentationRound&)>& on_round_done);
+
+} // namespace cubing
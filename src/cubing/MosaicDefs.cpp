@@ -3,10 +3,19 @@
 #include <fmt/format.h>
 #include "MosaicDefs.h"
 #include "ScrambleProcessing.h"
+#include "CompressedAlgFile.h"
+#include "ConvenienceScore.h"
+#include "Counters.h"
+#include "Tracing.h"
 
 namespace cubing {
 
+bool has_compressed_alg_file_extension(const std::string& path) {
+    return path.ends_with(COMPRESSED_ALGS_FILE_EXTENSION);
+}
+
 PatternToAlgMap PatternToAlgMap::load_from_file(const std::string& path, bool overwrite_with_empty) {
+    CUBING_TRACE_SPAN("load");
     if (!std::filesystem::exists(path)) {
         if (overwrite_with_empty) {
             // make sure we'll be able to use file later for writing
@@ -18,10 +27,14 @@ PatternToAlgMap PatternToAlgMap::load_from_file(const std::string& path, bool ov
         }
         return {};
     }
+    if (is_compressed_alg_file(path)) {
+        return {load_compressed_alg_file(path)};
+    }
     std::ifstream alg_file(path);
     if (!alg_file.is_open()) {
         throw std::runtime_error(fmt::format("Failed to open the file {}", path));
     }
+    CUBING_TRACE_SPAN("parse");
     std::unordered_map<std::string, std::string> result;
     std::string line;
     while (std::getline(alg_file, line)) {
@@ -37,6 +50,10 @@ PatternToAlgMap PatternToAlgMap::load_from_file(const std::string& path, bool ov
 }
 
 bool PatternToAlgMap::save_to_file(const std::string& path) const {
+    CUBING_TRACE_SPAN("save");
+    if (has_compressed_alg_file_extension(path)) {
+        return save_compressed_alg_file(path, _map);
+    }
     std::ofstream alg_file(path);
     if (!alg_file.is_open()) {
         return false;
@@ -63,15 +80,43 @@ size_t PatternToAlgMap::size() const {
 bool PatternToAlgMap::insert_if_shorter(const std::string& pattern, const std::string& alg) {
     // can't use _map[alg], because it may be empty (for GGGGGGGGG pattern) which is valid
     const auto itr = _map.find(pattern);
-    if (itr == _map.end() || itr->second.size() > alg.size()) {
+    if (itr == _map.end()) {
         _map.insert({pattern, alg});
         return true;
     }
+    if (itr->second.size() > alg.size()) {
+        itr->second = alg;
+        return true;
+    }
     return false;
 }
 
+bool PatternToAlgMap::insert_if_preferred(const std::string& pattern, const std::string& alg) {
+    const auto itr = _map.find(pattern);
+    if (itr == _map.end()) {
+        _map.insert({pattern, alg});
+        return true;
+    }
+    const auto& existing = itr->second;
+    if (existing.size() > alg.size() || (existing.size() == alg.size() && alg < existing)) {
+        itr->second = alg;
+        return true;
+    }
+    return false;
+}
+
+size_t PatternToAlgMap::merge(const PatternToAlgMap& other) {
+    CUBING_TRACE_SPAN("merge");
+    size_t num_changed = 0;
+    for (const auto& [pattern, alg] : other._map) {
+        num_changed += insert_if_preferred(pattern, alg);
+    }
+    return num_changed;
+}
+
 PatternToAlgAndConvenienceMap PatternToAlgAndConvenienceMap::load_from_file(const std::string& path, bool overwrite_with_empty) {
     auto m = PatternToAlgMap::load_from_file(path, overwrite_with_empty);
+    CUBING_TRACE_SPAN("score");
     PatternToAlgAndConvenienceMap result;
     for (const auto& [pattern, alg] : m.get()) {
         result._map.insert({pattern, {alg, execution_convenience_score(alg)}});
@@ -80,6 +125,15 @@ PatternToAlgAndConvenienceMap PatternToAlgAndConvenienceMap::load_from_file(cons
 }
 
 bool PatternToAlgAndConvenienceMap::save_to_file(const std::string& path) const {
+    CUBING_TRACE_SPAN("save");
+    if (has_compressed_alg_file_extension(path)) {
+        std::unordered_map<std::string, std::string> pattern_to_alg;
+        pattern_to_alg.reserve(_map.size());
+        for (const auto& [pattern, alg_and_score] : _map) {
+            pattern_to_alg.insert({pattern, alg_and_score.alg});
+        }
+        return save_compressed_alg_file(path, pattern_to_alg);
+    }
     std::ofstream alg_file(path);
     if (!alg_file.is_open()) {
         return false;
@@ -92,12 +146,15 @@ bool PatternToAlgAndConvenienceMap::save_to_file(const std::string& path) const
 }
 
 bool PatternToAlgAndConvenienceMap::insert_if_more_convenient(const std::string& pattern, const std::string& alg) {
+    CUBING_COUNT(convenienceMapLookups);
     const auto itr = _map.find(pattern);
     if (itr == _map.end()) {
+        CUBING_COUNT(convenienceMapInserts);
         _map.insert({pattern, {alg, execution_convenience_score(alg)}});
         return true;
     }
     if (const auto new_score = execution_convenience_score(alg); new_score < itr->second.convenience_score) {
+        CUBING_COUNT(convenienceMapImprovements);
         itr->second.alg = alg;
         itr->second.convenience_score = new_score;
         return true;
@@ -105,4 +162,28 @@ bool PatternToAlgAndConvenienceMap::insert_if_more_convenient(const std::string&
     return false;
 }
 
-}
\ No newline at end of file
+template<QtmMoveSetSize qtmMoveSetSize>
+bool PatternToAlgAndConvenienceMap::insert_if_more_convenient(const std::string& pattern,
+                                                              const MovesVector<qtmMoveSetSize>& moves) {
+    CUBING_COUNT(convenienceMapLookups);
+    const auto new_score = ConvenienceScorer<qtmMoveSetSize>::instance().score(moves);
+    const auto itr = _map.find(pattern);
+    if (itr != _map.end() && new_score >= itr->second.convenience_score) {
+        return false;
+    }
+    auto alg = qtmMoveSetSize == sidesAndMid333 ? moves.to_string_combined_moves() : moves.to_string();
+    if (itr == _map.end()) {
+        CUBING_COUNT(convenienceMapInserts);
+        _map.insert({pattern, {std::move(alg), new_score}});
+    } else {
+        CUBING_COUNT(convenienceMapImprovements);
+        itr->second = {std::move(alg), new_score};
+    }
+    return true;
+}
+
+template bool PatternToAlgAndConvenienceMap::insert_if_more_convenient(const std::string&, const MovesVector<sides333>&);
+template bool PatternToAlgAndConvenienceMap::insert_if_more_convenient(const std::string&, const MovesVector<sidesAndMid333>&);
+template bool PatternToAlgAndConvenienceMap::insert_if_more_convenient(const std::string&, const MovesVector<allMoves555>&);
+
+}
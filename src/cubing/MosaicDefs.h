@@ -1,6 +1,7 @@
 #pragma once
 #include <unordered_map>
 #include <string>
+#include "MovesVector.h"
 
 namespace cubing {
 
@@ -8,18 +9,30 @@ static constexpr size_t NUM_STICKERS_ON_ONE_SIDE = 9;
 static constexpr size_t NUM_STICKERS_AROUND_CENTER = 8;
 static constexpr std::string_view ALGS_FILE_NAME = "algs.txt";
 static constexpr std::string_view SCRAMBLE_FILE_NAME = "scramble.txt";
+static constexpr std::string_view STATS_FILE_NAME = "stats.json"; // see FinderTelemetry
+static constexpr std::string_view REACHABLE_PATTERNS_FILE_NAME = "reachable_patterns.bin"; // see PatternBitmap
+
+/// @returns true if algs should be saved to @param path in compressed format
+bool has_compressed_alg_file_extension(const std::string& path);
 
 class PatternToAlgMap {
 public:
     PatternToAlgMap() = default;
     // allow implicit init
     PatternToAlgMap(const std::unordered_map<std::string, std::string>& m) : _map(m) {}
+    /// reads both text and compressed (see CompressedAlgFile.h) files
     static PatternToAlgMap load_from_file(const std::string& path, bool overwrite_with_empty = false);
+    /// writes compressed file if @param path ends with COMPRESSED_ALGS_FILE_EXTENSION, text file otherwise
     [[nodiscard]] bool save_to_file(const std::string& path) const;
     bool exists(const std::string& pattern) const;
     /// @returns true if inserted
     bool insert(const std::string& pattern, const std::string& alg);
     bool insert_if_shorter(const std::string& pattern, const std::string& alg);
+    /// same as insert_if_shorter, but algs of the same size are replaced by lexicographically smaller ones, so that the
+    /// result doesn't depend on the insertion order
+    bool insert_if_preferred(const std::string& pattern, const std::string& alg);
+    /// inserts all algs from @param other with insert_if_preferred. @returns number of inserted or replaced algs
+    size_t merge(const PatternToAlgMap& other);
     std::unordered_map<std::string, std::string>& get() {return _map;}
     const std::unordered_map<std::string, std::string>& get() const {return _map;}
 
@@ -39,9 +52,12 @@ public:
     PatternToAlgAndConvenienceMap() = default;
     // calculate convenience score on load
     static PatternToAlgAndConvenienceMap load_from_file(const std::string& path, bool overwrite_with_empty = false);
-    [[nodiscard]] bool save_to_file(const std::string& path) const; // don't save convenience scores
+    [[nodiscard]] bool save_to_file(const std::string& path) const; // don't save convenience scores; same formats as PatternToAlgMap
     /// @returns true if inserted - TODO change alg type to MovesVector!
     bool insert_if_more_convenient(const std::string& pattern, const std::string& alg);
+    /// same, but scored on move codes with ConvenienceScorer; the alg string is only built if inserted
+    template<QtmMoveSetSize qtmMoveSetSize>
+    bool insert_if_more_convenient(const std::string& pattern, const MovesVector<qtmMoveSetSize>& moves);
 
     size_t size() const {return _map.size();}
     bool empty() const {return _map.empty();}
@@ -1,4 +1,5 @@
 #include "MovesVector.h"
+#include "ScrambleParser.h"
 #include <strutil.h>
 #include <bitset>
 #include <fmt/format.h>
@@ -21,6 +22,105 @@ static std::string move_to_string(uint8_t moveIndex) {
     return std::string{letter, prime_char};
 }
 
+/// @param mirrored_moves - image of every qtm move of allMoves555 ("RUFLDBMESrufldb" order), e.g. "L'U'..." for l2r
+/// @returns htm move -> htm move table for the moves of @param qtmMoveSetSize
+template<QtmMoveSetSize qtmMoveSetSize>
+static constexpr std::array<uint8_t, qtmMoveSetSize * 3> make_mirror_table(std::string_view mirrored_moves) {
+    constexpr std::string_view kAllMoves = "RUFLDBMESrufldb"; // qtmMoves of the smaller sets are its prefixes
+    std::array<uint8_t, qtmMoveSetSize * 3> table{};
+    size_t pos = 0;
+    for (uint8_t index = 0; index < qtmMoveSetSize; ++index) {
+        const uint8_t mirrored_index = kAllMoves.find(mirrored_moves[pos++]);
+        const bool flipped = pos < mirrored_moves.size() && mirrored_moves[pos] == '\'';
+        pos += flipped;
+        for (uint8_t direction = directionCw; direction <= directionCcw; ++direction) {
+            const uint8_t mirrored_direction = flipped ? directionCcw - direction : direction; // double stays double
+            table[index + qtmMoveSetSize * direction] = mirrored_index + qtmMoveSetSize * mirrored_direction;
+        }
+    }
+    return table;
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+static constexpr auto kInverseMoves = make_mirror_table<qtmMoveSetSize>("R'U'F'L'D'B'M'E'S'r'u'f'l'd'b'");
+template<QtmMoveSetSize qtmMoveSetSize>
+static constexpr auto kLeft2RightMoves = make_mirror_table<qtmMoveSetSize>("L'U'F'R'D'B'ME'S'l'u'f'r'd'b'");
+template<QtmMoveSetSize qtmMoveSetSize>
+static constexpr auto kFront2BackMoves = make_mirror_table<qtmMoveSetSize>("R'U'B'L'D'F'M'E'Sr'u'b'l'd'f'");
+
+template<QtmMoveSetSize qtmMoveSetSize>
+static constexpr auto kRight2FrontMoves = make_mirror_table<qtmMoveSetSize>("FULBDRS'EMfulbdr");
+template<QtmMoveSetSize qtmMoveSetSize>
+static constexpr auto kUp2FrontMoves = make_mirror_table<qtmMoveSetSize>("RFDLBUMS'Erfdlbu");
+
+template<QtmMoveSetSize qtmMoveSetSize, class Iterator>
+static MovesVector<qtmMoveSetSize> map_moves(Iterator begin, Iterator end, size_t size,
+                                             const std::array<uint8_t, qtmMoveSetSize * 3>& table) {
+    MovesVector<qtmMoveSetSize> result;
+    result.reserve(size);
+    for (auto itr = begin; itr != end; ++itr) {
+        result.push_back(table[*itr]);
+    }
+    return result;
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+MovesVector<qtmMoveSetSize> MovesVector<qtmMoveSetSize>::inverted() const {
+    return map_moves<qtmMoveSetSize>(moves_.rbegin(), moves_.rend(), moves_.size(), kInverseMoves<qtmMoveSetSize>);
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+MovesVector<qtmMoveSetSize> MovesVector<qtmMoveSetSize>::left2right() const {
+    return map_moves<qtmMoveSetSize>(moves_.begin(), moves_.end(), moves_.size(), kLeft2RightMoves<qtmMoveSetSize>);
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+MovesVector<qtmMoveSetSize> MovesVector<qtmMoveSetSize>::front2back() const {
+    return map_moves<qtmMoveSetSize>(moves_.begin(), moves_.end(), moves_.size(), kFront2BackMoves<qtmMoveSetSize>);
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+MovesVector<qtmMoveSetSize> MovesVector<qtmMoveSetSize>::right2front() const {
+    return map_moves<qtmMoveSetSize>(moves_.begin(), moves_.end(), moves_.size(), kRight2FrontMoves<qtmMoveSetSize>);
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+MovesVector<qtmMoveSetSize> MovesVector<qtmMoveSetSize>::up2front() const {
+    return map_moves<qtmMoveSetSize>(moves_.begin(), moves_.end(), moves_.size(), kUp2FrontMoves<qtmMoveSetSize>);
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+MovesVector<qtmMoveSetSize> MovesVector<qtmMoveSetSize>::canonicalized() const {
+    constexpr uint8_t kNumAxes = 3, kLayersPerAxis = qtmMoveSetSize / kNumAxes; // layer index = axis + 3 * i
+    const auto axis_of = [](uint8_t move) {return move % qtmMoveSetSize % kNumAxes;};
+    MovesVector<qtmMoveSetSize> result;
+    result.reserve(moves_.size());
+    InlineVector<uint32_t, 16> run_starts; // runs of parallel layer moves in result; adjacent runs are never parallel
+    std::array<uint8_t, kLayersPerAxis> quarter_turns{};
+    for (const uint8_t move : moves_) {
+        quarter_turns.fill(0);
+        if (!run_starts.empty() && axis_of(result.back()) == axis_of(move)) {
+            for (size_t i = run_starts.back(); i < result.size(); ++i) {
+                quarter_turns[result[i] % qtmMoveSetSize / kNumAxes] = result[i] / qtmMoveSetSize + 1;
+            }
+            result.moves_.resize(run_starts.back());
+        } else {
+            run_starts.push_back(result.size());
+        }
+        auto& turns = quarter_turns[move % qtmMoveSetSize / kNumAxes];
+        turns = (turns + move / qtmMoveSetSize + 1) % 4;
+        for (uint8_t i = 0; i < kLayersPerAxis; ++i) {
+            if (quarter_turns[i] != 0) {
+                result.push_back(axis_of(move) + kNumAxes * i + qtmMoveSetSize * (quarter_turns[i] - 1));
+            }
+        }
+        if (result.size() == run_starts.back()) {
+            run_starts.pop_back(); // cancelled out, so the previous run may merge with the next move
+        }
+    }
+    return result;
+}
+
 template<QtmMoveSetSize qtmMoveSetSize>
 std::string MovesVector<qtmMoveSetSize>::to_string(bool as_digits) const {
     std::ostringstream ss;
@@ -130,22 +230,16 @@ std::string MovesVector<qtmMoveSetSize>::to_string_combined_moves() const {
 template<QtmMoveSetSize qtmMoveSetSize>
 MovesVector<qtmMoveSetSize> MovesVector<qtmMoveSetSize>::from_string(const std::vector<std::string>& scramble_moves) {
     MovesVector<qtmMoveSetSize> scrambleInt;
+    scrambleInt.reserve(scramble_moves.size());
     for (const auto& moveString : scramble_moves) {
-        const auto itr = std::find(CubeTraits<qtmMoveSetSize>::qtmMoves.begin(), CubeTraits<qtmMoveSetSize>::qtmMoves.end(), moveString.front());
-        if (itr == CubeTraits<qtmMoveSetSize>::qtmMoves.end()) {
-            throw std::runtime_error("from_string: invalid move <" + moveString + ">");
-        }
-        const uint8_t index = itr - CubeTraits<qtmMoveSetSize>::qtmMoves.begin();
-        const uint8_t shift = moveString.size() == 1
-                              ? 0 : qtmMoveSetSize * (uint8_t(1) + uint8_t(moveString.back() == '\''));
-        scrambleInt.push_back(index + shift);
+        ScrambleParser<qtmMoveSetSize>::parse(moveString, scrambleInt);
     }
     return scrambleInt;
 }
 
 template<QtmMoveSetSize qtmMoveSetSize>
 MovesVector<qtmMoveSetSize> MovesVector<qtmMoveSetSize>::from_string(const std::string& scramble) {
-    return scramble.empty() ? MovesVector<qtmMoveSetSize>() : from_string(strutil::split(scramble, ' '));
+    return ScrambleParser<qtmMoveSetSize>::parse(scramble);
 }
 
 }
\ No newline at end of file
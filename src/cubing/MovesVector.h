@@ -1,5 +1,6 @@
 #pragma once
 #include "CubingDefs.h"
+#include "InlineVector.h"
 #include <string>
 #include <bitset>
 
@@ -9,13 +10,17 @@ namespace cubing {
 template<QtmMoveSetSize qtmMoveSetSize>
 class MovesVector {
 public:
+    /// algs up to this size are stored without heap allocations
+    static constexpr size_t INLINE_CAPACITY = 56;
+
     size_t size() const {return moves_.size();}
     void clear() {return moves_.clear();}
-    bool empty() {return moves_.empty();}
+    bool empty() const {return moves_.empty();}
     /// @returns move count, where <R' M> is considered a single move (Rw'), as well as <F S B'> is single move (z), but
     /// <F2 S B'> is two, and <S F2 B'> is three.
 //    size_t move_count_combined() const;
     void push_back(uint8_t moveIndex) {moves_.push_back(moveIndex);}
+    void reserve(size_t size) {moves_.reserve(size);}
     uint8_t& operator[](size_t i) {return moves_[i];}
     const uint8_t& operator[](size_t i) const {return moves_[i];}
     uint8_t& front() {return moves_.front();}
@@ -28,13 +33,31 @@ public:
     auto begin() const {return moves_.begin();}
     auto end() const {return moves_.end();}
 
+    /// @returns moves in reverse order with opposite directions, e.g. R U F2 -> F2 U' R'
+    MovesVector<qtmMoveSetSize> inverted() const;
+    /// @returns moves mirrored through the M plane, e.g. R U M r -> L' U' M l'
+    MovesVector<qtmMoveSetSize> left2right() const;
+    /// @returns moves mirrored through the S plane, e.g. F R S f -> B' R' S b'
+    MovesVector<qtmMoveSetSize> front2back() const;
+    /// @returns moves for a cube held rotated with y', so that they show on F and B what the original moves show on R
+    /// and L (with other colors), e.g. R U M r -> F U S' f
+    MovesVector<qtmMoveSetSize> right2front() const;
+    /// @returns moves for a cube held rotated with x, so that they show on F and B what the original moves show on U
+    /// and D (with other colors), e.g. R U E u -> R F S' f
+    MovesVector<qtmMoveSetSize> up2front() const;
+
+    /// @returns equivalent moves with runs of parallel layer moves merged, cancelled and sorted by layer, e.g.
+    /// <L R L'> -> <R>, <M R2 U U' R2> -> <M>, <L' R> -> <R L'>. That's the order IterativeScramble enumerates in.
+    MovesVector<qtmMoveSetSize> canonicalized() const;
+
     std::string to_string(bool as_digits = false) const;
     std::string to_string_combined_moves() const;
-    /// @throws runtime_error if scramble is invalid or not normalized
+    /// parses the scramble with ScrambleParser
+    /// @throws ScrambleParseError (runtime_error) if scramble is invalid or not normalized
     static MovesVector<qtmMoveSetSize> from_string(const std::vector<std::string>& scramble_moves);
     static MovesVector<qtmMoveSetSize> from_string(const std::string& scramble);
 private:
-    std::vector<uint8_t> moves_;
+    InlineVector<uint8_t, INLINE_CAPACITY> moves_;
 };
 
 template class MovesVector<sides333>;
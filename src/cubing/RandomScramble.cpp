@@ -0,0 +1,96 @@
+#include "RandomScramble.h"
+#include <algorithm>
+#include <cmath>
+
+namespace cubing {
+
+template<QtmMoveSetSize qtmMoveSetSize>
+void RandomScramble<qtmMoveSetSize>::extend_tables(size_t length) {
+    if (num_continuations_.empty()) {
+        num_continuations_.emplace_back().fill(1.); // the empty continuation
+        cumulative_.emplace_back();
+        log10_scale_.push_back(0.);
+    }
+    while (num_continuations_.size() <= length) {
+        const auto& shorter = num_continuations_.back();
+        std::array<double, NUM_PREVIOUS_STATES> counts{};
+        std::array<std::array<double, qtmMoveSetSize>, NUM_PREVIOUS_STATES> cumulative{};
+        for (size_t previous = 0; previous < NUM_PREVIOUS_STATES; ++previous) {
+            size_t last_allowed = 0;
+            for (size_t layer = 0; layer < qtmMoveSetSize; ++layer) {
+                // same rule as IterativeScramble: parallel layer moves must be strictly sorted by layer
+                const bool allowed = previous == NO_PREVIOUS_LAYER || previous < layer
+                                     || !CubeTraits<qtmMoveSetSize>::are_parallel_layer_moves(previous, layer);
+                if (allowed) {
+                    counts[previous] += 3 * shorter[layer]; // 3 directions
+                    last_allowed = layer;
+                }
+                cumulative[previous][layer] = counts[previous];
+            }
+            for (size_t layer = 0; layer < qtmMoveSetSize; ++layer) {
+                cumulative[previous][layer] = layer >= last_allowed ? 1. : cumulative[previous][layer] / counts[previous];
+            }
+        }
+        const double scale = *std::max_element(counts.begin(), counts.end());
+        for (auto& count : counts) {
+            count /= scale;
+        }
+        log10_scale_.push_back(log10_scale_.back() + std::log10(scale));
+        num_continuations_.push_back(counts);
+        cumulative_.push_back(cumulative);
+    }
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+void RandomScramble<qtmMoveSetSize>::next(size_t length, MovesVector<qtmMoveSetSize>& moves) {
+    extend_tables(length);
+    moves.clear();
+    moves.reserve(length);
+    size_t previous = NO_PREVIOUS_LAYER;
+    for (size_t remaining = length; remaining > 0; --remaining) {
+        const auto& cumulative = cumulative_[remaining][previous];
+        const double u = rng_.uniform();
+        size_t layer = 0;
+        while (u >= cumulative[layer]) {
+            ++layer;
+        }
+        const auto direction = uint8_t(((rng_() >> 32) * 3) >> 32); // uniform in [0, 3)
+        moves.push_back(uint8_t(layer + qtmMoveSetSize * direction));
+        previous = layer;
+    }
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+MovesVector<qtmMoveSetSize> RandomScramble<qtmMoveSetSize>::next(size_t length) {
+    MovesVector<qtmMoveSetSize> moves;
+    next(length, moves);
+    return moves;
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+std::vector<MovesVector<qtmMoveSetSize>> RandomScramble<qtmMoveSetSize>::generate(size_t length, size_t count) {
+    std::vector<MovesVector<qtmMoveSetSize>> result(count);
+    for (auto& moves : result) {
+        next(length, moves);
+    }
+    return result;
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+std::vector<CubeState<qtmMoveSetSize>> RandomScramble<qtmMoveSetSize>::generate_states(size_t length, size_t count) {
+    std::vector<CubeState<qtmMoveSetSize>> result(count);
+    MovesVector<qtmMoveSetSize> moves;
+    for (auto& state : result) {
+        next(length, moves);
+        state.applyScramble(moves);
+    }
+    return result;
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+double RandomScramble<qtmMoveSetSize>::log10_num_sequences(size_t length) {
+    extend_tables(length);
+    return std::log10(num_continuations_[length][NO_PREVIOUS_LAYER]) + log10_scale_[length];
+}
+
+} // namespace cubing
@@ -0,0 +1,97 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "CubingDefs.h"
+#include "CubeState.h"
+#include "MovesVector.h"
+
+namespace cubing {
+
+/// xoshiro256** PRNG seeded with splitmix64: much faster than std::mt19937_64 and good enough for sampling. Satisfies
+/// UniformRandomBitGenerator, so it works with <random> distributions too.
+class Xoshiro256 {
+public:
+    using result_type = uint64_t;
+
+    explicit Xoshiro256(uint64_t seed) {
+        for (auto& s : state_) {
+            seed += 0x9e3779b97f4a7c15ULL; // splitmix64
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            s = z ^ (z >> 31);
+        }
+    }
+
+    static constexpr result_type min() {return 0;}
+    static constexpr result_type max() {return std::numeric_limits<result_type>::max();}
+
+    result_type operator()() {
+        const uint64_t result = rotl(state_[1] * 5, 7) * 9;
+        const uint64_t t = state_[1] << 17;
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = rotl(state_[3], 45);
+        return result;
+    }
+
+    /// @returns uniform double in [0, 1)
+    double uniform() {return double((*this)() >> 11) * 0x1.0p-53;}
+
+private:
+    static uint64_t rotl(uint64_t x, int k) {return (x << k) | (x >> (64 - k));}
+
+    uint64_t state_[4];
+};
+
+/*
+ * Uniformly random canonical move sequences, i.e. sequences that IterativeScramble visits: parallel layer moves are
+ * strictly sorted by layer, so <R R2> and <L R> never show up but <R L> does. Picking moves uniformly would oversample
+ * moves that few continuations are allowed after, so each next move is weighted by the number of canonical
+ * continuations it leaves, counted per remaining length and previous layer.
+ */
+template<QtmMoveSetSize qtmMoveSetSize>
+class RandomScramble {
+public:
+    explicit RandomScramble(uint64_t seed) : rng_(seed) {}
+
+    /// @returns uniformly random canonical sequence of @param length moves
+    MovesVector<qtmMoveSetSize> next(size_t length);
+    /// same, reusing @param moves
+    void next(size_t length, MovesVector<qtmMoveSetSize>& moves);
+
+    /// @returns @param count random sequences of @param length moves
+    std::vector<MovesVector<qtmMoveSetSize>> generate(size_t length, size_t count);
+    /// @returns states of solved cubes scrambled with @param count random sequences of @param length moves
+    std::vector<CubeState<qtmMoveSetSize>> generate_states(size_t length, size_t count);
+
+    /// @returns decimal logarithm of the number of canonical sequences of @param length moves
+    double log10_num_sequences(size_t length);
+
+    Xoshiro256& rng() {return rng_;}
+
+private:
+    static constexpr size_t NO_PREVIOUS_LAYER = qtmMoveSetSize; // before the first move
+    static constexpr size_t NUM_PREVIOUS_STATES = qtmMoveSetSize + 1;
+
+    /// makes sure continuations of up to @param length moves are counted
+    void extend_tables(size_t length);
+
+    Xoshiro256 rng_;
+    // [remaining length][previous layer][next layer]: probability that a canonical continuation of that length
+    // starts on a layer <= next layer
+    std::vector<std::array<std::array<double, qtmMoveSetSize>, NUM_PREVIOUS_STATES>> cumulative_;
+    // [remaining length][previous layer]: number of canonical continuations, scaled per length to avoid overflow
+    std::vector<std::array<double, NUM_PREVIOUS_STATES>> num_continuations_;
+    std::vector<double> log10_scale_; // [remaining length]: scaling applied to num_continuations_
+};
+
+template class RandomScramble<sides333>;
+template class RandomScramble<sidesAndMid333>;
+template class RandomScramble<allMoves555>;
+
+} // namespace cubing
@@ -0,0 +1,214 @@
+#include "ReachablePatterns.h"
+#include "CubingDefs.h"
+#include "CubeState.h"
+#include "FacePatternPredicate.h"
+#include "MosaicDefs.h"
+#include <array>
+#include <bit>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <fmt/format.h>
+
+namespace cubing {
+
+static constexpr std::string_view kMagic = "PATB";
+static constexpr uint8_t kVersion = 1;
+static constexpr std::string_view kColors = "WGROYB";
+static constexpr size_t kNumBytes = NUM_PATTERNS / 8;
+
+size_t PatternBitmap::count() const {
+    size_t result = 0;
+    for (const auto word : bits_) {
+        result += std::popcount(word);
+    }
+    return result;
+}
+
+PatternBitmap PatternBitmap::with_center(char color) const {
+    const auto center = kColors.find(color);
+    PatternBitmap result;
+    for (uint32_t index = 0; index < NUM_PATTERNS; ++index) {
+        if (contains(index) && index / 1296 % 6 == center) { // center is the 5th of 9 base-6 digits
+            result.insert(index);
+        }
+    }
+    return result;
+}
+
+bool PatternBitmap::save_to_file(const std::string& path) const {
+    std::string data(kMagic);
+    data.push_back(char(kVersion));
+    for (size_t i = 0; i < 4; ++i) {
+        data.push_back(char(uint32_t(NUM_PATTERNS) >> (8 * i)));
+    }
+    for (size_t i = 0; i < kNumBytes; ++i) {
+        data.push_back(char(bits_[i / 8] >> (8 * (i % 8))));
+    }
+    std::ofstream file(path, std::ios::binary);
+    return file.write(data.data(), std::streamsize(data.size())) && file.flush();
+}
+
+PatternBitmap PatternBitmap::load_from_file(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error(fmt::format("PatternBitmap: failed to open {}", path));
+    }
+    const std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    const size_t header_size = kMagic.size() + 1 + 4;
+    uint32_t num_patterns = 0;
+    for (size_t i = 0; i < 4 && kMagic.size() + 1 + i < data.size(); ++i) {
+        num_patterns |= uint32_t(uint8_t(data[kMagic.size() + 1 + i])) << (8 * i);
+    }
+    if (data.size() != header_size + kNumBytes || data.compare(0, kMagic.size(), kMagic) != 0
+        || uint8_t(data[kMagic.size()]) != kVersion || num_patterns != NUM_PATTERNS) {
+        throw std::runtime_error(fmt::format("PatternBitmap: {} is not a pattern bitmap file", path));
+    }
+    PatternBitmap result;
+    for (size_t i = 0; i < kNumBytes; ++i) {
+        result.bits_[i / 8] |= uint64_t(uint8_t(data[header_size + i])) << (8 * (i % 8));
+    }
+    return result;
+}
+
+/*
+ * Reachability of a pattern splits by orbit, since the F and B stickers pin down one sticker of every corner and of the
+ * 8 edges around F and B, but none of the 4 edges of the S slice (UL, UR, DL, DR):
+ * - corners: cubies containing the F and B colors must fit all 8 positions with twists summing to 0 mod 3
+ * - edges: cubies containing the F and B colors must fit the 8 positions. Flipping or swapping the free S slice edges
+ *   fixes edge orientation and any permutation parity (so corner parity doesn't matter either)
+ * - centers: slice moves bring any color to F, with the opposite one on B
+ * With 4 corner and 4 edge stickers on F, that's 6^4 checks per orbit, each a small backtracking search.
+ */
+namespace {
+
+struct StickerConstraint {
+    uint8_t position;
+    uint8_t slot; // which sticker of the position
+    uint8_t color;
+};
+
+/// @returns slot of the U or D sticker of @param position, the reference for corner twists
+uint8_t ud_slot(const std::vector<std::string>& config, size_t position, size_t num_slots) {
+    for (uint8_t slot = 0; slot < num_slots; ++slot) {
+        const char face = config[position * num_slots + slot][0];
+        if (face == 'U' || face == 'D') {
+            return slot;
+        }
+    }
+    throw std::logic_error("ud_slot: no U or D sticker");
+}
+
+/// @returns true if distinct cubies can be placed so that all @param constraints hold; for corners, their twists have to
+/// sum to 0 mod 3. Cubies are numbered by their solved positions, their stickers are turned by some slots.
+bool can_place_cubies(const Elements24State& solved, const std::vector<std::string>& config, size_t num_slots,
+                      const std::vector<StickerConstraint>& constraints) {
+    const size_t num_cubies = solved.size() / num_slots;
+    const bool corners = num_slots == 3;
+    std::function<bool(size_t, uint32_t, size_t)> place = [&](size_t i, uint32_t used, size_t twist) {
+        if (i == constraints.size()) {
+            return !corners || twist % 3 == 0;
+        }
+        const auto& constraint = constraints[i];
+        for (uint8_t cubie = 0; cubie < num_cubies; ++cubie) {
+            if (used & (1u << cubie)) {
+                continue;
+            }
+            for (uint8_t cubie_slot = 0; cubie_slot < num_slots; ++cubie_slot) {
+                if (solved[cubie * num_slots + cubie_slot] != constraint.color) {
+                    continue;
+                }
+                // slot s of the position gets the cubie sticker (s + turn) % num_slots
+                const size_t turn = (cubie_slot + num_slots - constraint.slot) % num_slots;
+                size_t cubie_twist = 0;
+                if (corners) {
+                    const size_t reference_slot = (ud_slot(config, cubie, 3) + 3 - turn) % 3;
+                    cubie_twist = (reference_slot + 3 - ud_slot(config, constraint.position, 3)) % 3;
+                }
+                if (place(i + 1, used | (1u << cubie), twist + cubie_twist)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    };
+    return place(0, 0, 0);
+}
+
+/// @returns for each combination of colors of the F stickers @param keys (base 6, first key most significant), whether
+/// cubies can show them on F and the opposite colors on B
+std::vector<bool> placeable_combinations(const FacePatternPredicate<sidesAndMid333>& mosaic,
+                                         const std::vector<size_t>& keys, const Elements24State& solved,
+                                         const std::vector<std::string>& config, size_t num_slots) {
+    std::vector<bool> result;
+    std::vector<StickerConstraint> constraints;
+    for (size_t combination = 0, num_combinations = size_t(std::pow(6, keys.size()));
+         combination < num_combinations; ++combination) {
+        constraints.clear();
+        for (size_t i = 0, digits = combination; i < keys.size(); ++i, digits /= 6) {
+            const auto& check = mosaic.checks()[keys[keys.size() - 1 - i]];
+            const auto color = uint8_t(digits % 6);
+            const auto add_constraint = [&](const FaceSticker& sticker, uint8_t sticker_color) {
+                constraints.push_back({uint8_t(sticker.index / num_slots), uint8_t(sticker.index % num_slots),
+                                       sticker_color});
+            };
+            add_constraint(check.lhs, color);
+            add_constraint(check.rhs, check.expected[color]);
+        }
+        result.push_back(can_place_cubies(solved, config, num_slots, constraints));
+    }
+    return result;
+}
+
+} // namespace
+
+PatternBitmap reachable_two_sided_mosaic_patterns() {
+    // lhs of check i is the F sticker i of the pattern, rhs the B sticker facing it
+    const auto mosaic = FacePatternPredicate<sidesAndMid333>::compile(TWO_SIDED_MOSAIC_PREDICATE);
+    std::vector<size_t> corner_keys, edge_keys;
+    size_t center_key = 0;
+    for (size_t i = 0; i < mosaic.checks().size(); ++i) {
+        const auto orbit = mosaic.checks()[i].lhs.orbit;
+        if (orbit == CubeState<sidesAndMid333>::cornerStickers) {
+            corner_keys.push_back(i);
+        } else if (orbit == CubeState<sidesAndMid333>::edgeStickers) {
+            edge_keys.push_back(i);
+        } else {
+            center_key = i;
+        }
+    }
+    const auto corners = placeable_combinations(mosaic, corner_keys, cornersStateInitial, cornersConfig, 3);
+    const auto edges = placeable_combinations(mosaic, edge_keys, edgesStateInitial, edgesConfig, 2);
+
+    const auto set_digits = [](std::array<uint8_t, NUM_STICKERS_ON_ONE_SIDE>& digits, const std::vector<size_t>& keys,
+                               size_t combination) {
+        for (size_t i = keys.size(); i-- > 0; combination /= 6) {
+            digits[keys[i]] = uint8_t(combination % 6);
+        }
+    };
+    PatternBitmap result;
+    std::array<uint8_t, NUM_STICKERS_ON_ONE_SIDE> digits{};
+    for (size_t corner_combination = 0; corner_combination < corners.size(); ++corner_combination) {
+        if (!corners[corner_combination]) {
+            continue;
+        }
+        set_digits(digits, corner_keys, corner_combination);
+        for (size_t edge_combination = 0; edge_combination < edges.size(); ++edge_combination) {
+            if (!edges[edge_combination]) {
+                continue;
+            }
+            set_digits(digits, edge_keys, edge_combination);
+            for (uint8_t center = 0; center < 6; ++center) {
+                digits[center_key] = center;
+                uint32_t index = 0;
+                for (const auto digit : digits) {
+                    index = index * 6 + digit;
+                }
+                result.insert(index);
+            }
+        }
+    }
+    return result;
+}
+
+} // namespace cubing
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "CompressedAlgFile.h"
+
+namespace cubing {
+
+static constexpr size_t NUM_PATTERNS = 10'077'696; // 6^9 patterns of 9 stickers
+
+/*
+ * One bit per 9-sticker pattern, indexed by pattern_to_index(). File layout (little-endian):
+ *   "PATB" u8:version u32:num_patterns, then num_patterns bits, pattern i in bit (i % 8) of byte i / 8
+ */
+class PatternBitmap {
+public:
+    PatternBitmap() : bits_((NUM_PATTERNS + 63) / 64) {}
+
+    bool contains(uint32_t index) const {return (bits_[index / 64] >> (index % 64)) & 1;}
+    /// @throws runtime_error if @param pattern is invalid, see pattern_to_index
+    bool contains(std::string_view pattern) const {return contains(pattern_to_index(pattern));}
+    void insert(uint32_t index) {bits_[index / 64] |= uint64_t(1) << (index % 64);}
+    void insert(std::string_view pattern) {insert(pattern_to_index(pattern));}
+
+    /// @returns number of patterns in the bitmap
+    size_t count() const;
+    /// @returns bitmap of the patterns with center @param color, e.g. 'G' for algs without slice moves
+    PatternBitmap with_center(char color) const;
+
+    /// @returns false if the file can't be written
+    [[nodiscard]] bool save_to_file(const std::string& path) const;
+    /// @throws runtime_error if the file can't be read or is corrupted
+    static PatternBitmap load_from_file(const std::string& path);
+
+    bool operator==(const PatternBitmap& other) const = default;
+
+private:
+    std::vector<uint64_t> bits_;
+};
+
+/// @returns F patterns of all states whose B face has the same pattern with opposite colors, i.e. the patterns
+/// find_two_sided_mosaic_algs can find with slice moves. See the .cpp for how they are derived.
+PatternBitmap reachable_two_sided_mosaic_patterns();
+
+} // namespace cubing
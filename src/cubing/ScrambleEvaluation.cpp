@@ -0,0 +1,139 @@
+#include "ScrambleEvaluation.h"
+#include "CubeState.h"
+#include "ScrambleParser.h"
+#include <thread>
+#include <fmt/format.h>
+
+namespace cubing {
+
+static constexpr size_t STATE_STRING_SIZE = 24 + 1 + 24; // corners|edges
+
+static size_t field_size(EvaluationField field) {
+    switch (field) {
+        case EvaluationField::state: return STATE_STRING_SIZE;
+        case EvaluationField::top:
+        case EvaluationField::front: return 9;
+        default: return 1;
+    }
+}
+
+EvaluationField evaluation_field_from_string(const std::string& name) {
+    if (name == "state") return EvaluationField::state;
+    if (name == "top") return EvaluationField::top;
+    if (name == "front") return EvaluationField::front;
+    if (name == "mosaic") return EvaluationField::mosaic;
+    throw std::runtime_error(fmt::format("unknown field <{}>, expected state, top, front or mosaic", name));
+}
+
+size_t binary_record_size(const std::vector<EvaluationField>& fields) {
+    size_t size = 1; // status
+    for (const auto field : fields) {
+        size += field_size(field);
+    }
+    return size;
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+static std::string field_value(const CubeState<qtmMoveSetSize>& cube, EvaluationField field) {
+    switch (field) {
+        case EvaluationField::state: return cube.toString();
+        case EvaluationField::top: return cube.topSideStickers();
+        case EvaluationField::front: return cube.frontSideStickers();
+        default: return cube.doFrontAndBackSidesHaveSamePatternWithOppositeColors() ? "1" : "0";
+    }
+}
+
+/// appends records of @param lines to @param output
+template<QtmMoveSetSize qtmMoveSetSize>
+static void evaluate_batch(const std::vector<std::string>& lines, const ScrambleEvaluationOptions& options,
+                           std::string& output) {
+    const bool binary = options.format == EvaluationOutputFormat::binary;
+    const size_t record_size = binary_record_size(options.fields);
+    output.clear();
+    output.reserve(lines.size() * (binary ? record_size : 64));
+    MovesVector<qtmMoveSetSize> moves;
+    for (const auto& line : lines) {
+        moves.clear();
+        const size_t error_position = ScrambleParser<qtmMoveSetSize>::try_parse(line, moves);
+        const bool ok = error_position == std::string_view::npos;
+        CubeState<qtmMoveSetSize> cube;
+        if (ok) {
+            cube.applyScramble(moves);
+        }
+        if (binary) {
+            output.push_back(char(ok));
+            for (const auto field : options.fields) {
+                if (ok) {
+                    output += field_value(cube, field);
+                } else {
+                    output.append(field_size(field), '\0');
+                }
+            }
+            continue;
+        }
+        output += line;
+        if (!ok) {
+            output += fmt::format("\terror: invalid move at {}\n", error_position);
+            continue;
+        }
+        for (const auto field : options.fields) {
+            output.push_back('\t');
+            output += field_value(cube, field);
+        }
+        output.push_back('\n');
+    }
+}
+
+/// @returns number of lines read into @param batches, at most lines_per_batch per batch
+static size_t read_batches(std::istream& in, std::vector<std::vector<std::string>>& batches, size_t lines_per_batch) {
+    size_t num_lines = 0;
+    for (auto& batch : batches) {
+        batch.clear();
+        std::string line;
+        while (batch.size() < lines_per_batch && std::getline(in, line)) {
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            batch.push_back(std::move(line));
+        }
+        num_lines += batch.size();
+    }
+    return num_lines;
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+size_t evaluate_scrambles(std::istream& in, std::ostream& out, const ScrambleEvaluationOptions& options) {
+    const size_t num_threads = std::max<size_t>(1, options.num_threads);
+    const size_t lines_per_batch = std::max<size_t>(1, options.lines_per_batch);
+    // workers evaluate one group of batches while the next one is being read
+    std::vector<std::vector<std::string>> current(num_threads), next(num_threads);
+    std::vector<std::string> outputs(num_threads);
+    size_t num_evaluated = 0;
+    for (size_t num_lines = read_batches(in, current, lines_per_batch); num_lines > 0; ) {
+        std::vector<std::thread> workers;
+        for (size_t i = 0; i < num_threads; ++i) {
+            if (!current[i].empty()) {
+                workers.emplace_back([&, i] {evaluate_batch<qtmMoveSetSize>(current[i], options, outputs[i]);});
+            }
+        }
+        const size_t num_next_lines = read_batches(in, next, lines_per_batch);
+        for (size_t i = 0; i < workers.size(); ++i) {
+            workers[i].join();
+            out.write(outputs[i].data(), std::streamsize(outputs[i].size()));
+        }
+        if (!out) {
+            throw std::runtime_error("evaluate_scrambles: failed to write output");
+        }
+        num_evaluated += num_lines;
+        num_lines = num_next_lines;
+        std::swap(current, next);
+    }
+    out.flush();
+    return num_evaluated;
+}
+
+template size_t evaluate_scrambles<sides333>(std::istream&, std::ostream&, const ScrambleEvaluationOptions&);
+template size_t evaluate_scrambles<sidesAndMid333>(std::istream&, std::ostream&, const ScrambleEvaluationOptions&);
+template size_t evaluate_scrambles<allMoves555>(std::istream&, std::ostream&, const ScrambleEvaluationOptions&);
+
+} // namespace cubing
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "CubingDefs.h"
+
+namespace cubing {
+
+/// CubeState outputs that can be evaluated for each scramble
+enum class EvaluationField : uint8_t {
+    state,  // CubeState::toString(), 49 chars
+    top,    // topSideStickers(), 9 chars
+    front,  // frontSideStickers(), 9 chars
+    mosaic, // doFrontAndBackSidesHaveSamePatternWithOppositeColors(), '0' or '1'
+};
+
+/// @returns field for names "state", "top", "front" and "mosaic"
+/// @throws runtime_error for unknown names
+EvaluationField evaluation_field_from_string(const std::string& name);
+
+/*
+ * Output formats, one record per input line, in input order:
+ * - tsv: scramble, then the fields separated by tabs. Scrambles that fail to parse get a single "error: ..." field.
+ * - binary: fixed-size records, so record i is at offset i * binary_record_size(). Each record starts with a status
+ *   byte (1 = ok, 0 = parse error) followed by the fields as fixed-size chars, zero-filled on errors.
+ */
+enum class EvaluationOutputFormat : uint8_t {tsv, binary};
+
+struct ScrambleEvaluationOptions {
+    std::vector<EvaluationField> fields{EvaluationField::front, EvaluationField::mosaic};
+    EvaluationOutputFormat format{EvaluationOutputFormat::tsv};
+    size_t num_threads{1};
+    size_t lines_per_batch{1 << 16};
+};
+
+/// @returns size of a binary record with @param fields
+size_t binary_record_size(const std::vector<EvaluationField>& fields);
+
+/// Reads scrambles line by line from @param in and writes their records to @param out. Batches of lines are evaluated
+/// on worker threads while the next batches are read; at most 2 * num_threads batches are held in memory, so inputs of
+/// any size stream through.
+/// @returns number of scrambles evaluated, including the ones that failed to parse
+template<QtmMoveSetSize qtmMoveSetSize>
+size_t evaluate_scrambles(std::istream& in, std::ostream& out, const ScrambleEvaluationOptions& options);
+
+} // namespace cubing
@@ -0,0 +1,192 @@
+#include "ScrambleParser.h"
+#include "Counters.h"
+#include <fmt/format.h>
+
+namespace cubing {
+
+ScrambleParseError::ScrambleParseError(const std::string& message, size_t position) :
+    std::runtime_error(fmt::format("{} at position {}", message, position)),
+    position_(position) {
+}
+
+namespace {
+
+/// qtm layer move and whether it turns opposite to the face it belongs to, e.g. M' is a layer of R
+struct Layer {
+    uint8_t index;
+    bool flipped;
+};
+
+static constexpr size_t MAX_LAYERS = 5;
+
+/// layers of every face from the outside in: R r M' l' L' on 555, R M' L' on 333 with slices, just R otherwise
+template<QtmMoveSetSize qtmMoveSetSize>
+struct FaceLayers {
+    uint8_t depth;
+    std::array<std::array<Layer, MAX_LAYERS>, 6> layers;
+};
+
+template<QtmMoveSetSize qtmMoveSetSize>
+constexpr FaceLayers<qtmMoveSetSize> make_face_layers() {
+    constexpr uint8_t kFirstSlice = 6, kFirstInner = 9;
+    constexpr std::array<bool, 6> kSliceFlipped = {true, true, false, false, false, true}; // M, E, S follow L, D, F
+    FaceLayers<qtmMoveSetSize> result{};
+    result.depth = qtmMoveSetSize == sides333 ? 1 : qtmMoveSetSize == sidesAndMid333 ? 3 : 5;
+    for (uint8_t face = 0; face < 6; ++face) {
+        const uint8_t opposite = (face + 3) % 6;
+        const Layer outer{face, false}, slice{uint8_t(kFirstSlice + face % 3), kSliceFlipped[face]};
+        const Layer inner{uint8_t(kFirstInner + face), false}, opposite_inner{uint8_t(kFirstInner + opposite), true};
+        const Layer opposite_outer{opposite, true};
+        switch (result.depth) {
+            case 1: result.layers[face] = {outer}; break;
+            case 3: result.layers[face] = {outer, slice, opposite_outer}; break;
+            default: result.layers[face] = {outer, inner, slice, opposite_inner, opposite_outer}; break;
+        }
+    }
+    return result;
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+static constexpr auto kFaceLayers = make_face_layers<qtmMoveSetSize>();
+
+enum class LetterKind : uint8_t {
+    none,
+    face,      // RUFLDB
+    lowercase, // rufldb
+    slice,     // MES
+    rotation,  // xyz
+};
+
+struct Letter {
+    LetterKind kind;
+    uint8_t index; // face for faces, lowercase letters and rotations; qtm move index for slices
+};
+
+constexpr std::array<Letter, 128> make_letters() {
+    std::array<Letter, 128> letters{};
+    constexpr std::string_view kFaces = "RUFLDB", kLowercase = "rufldb", kSlices = "MES", kRotations = "xyz";
+    for (uint8_t i = 0; i < 6; ++i) {
+        letters[kFaces[i]] = {LetterKind::face, i};
+        letters[kLowercase[i]] = {LetterKind::lowercase, i};
+    }
+    for (uint8_t i = 0; i < 3; ++i) {
+        letters[kSlices[i]] = {LetterKind::slice, uint8_t(6 + i)};
+        letters[kRotations[i]] = {LetterKind::rotation, i}; // x, y, z turn like R, U, F
+    }
+    return letters;
+}
+
+static constexpr auto kLetters = make_letters();
+
+inline bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+/// @returns error message, or nullptr if @param scramble is valid
+template<QtmMoveSetSize qtmMoveSetSize>
+const char* parse_moves(std::string_view scramble, MovesVector<qtmMoveSetSize>& moves, size_t& error_position) {
+    CUBING_COUNT(scrambleParses);
+    [[maybe_unused]] const size_t initial_size = moves.size();
+    const auto& face_layers = kFaceLayers<qtmMoveSetSize>;
+    const size_t size = scramble.size();
+    size_t pos = 0;
+    while (pos < size) {
+        if (is_space(scramble[pos])) {
+            ++pos;
+            continue;
+        }
+        error_position = pos;
+        // [234]? letter w? (' | 2 | 2' | '2)?
+        uint8_t prefix = 0;
+        if (scramble[pos] >= '2' && scramble[pos] <= '4') {
+            prefix = scramble[pos++] - '0';
+        }
+        const char c = pos < size ? scramble[pos] : '\0';
+        const Letter letter = (c & 0x80) ? Letter{} : kLetters[c];
+        if (letter.kind == LetterKind::none) {
+            error_position = pos;
+            return pos < size ? "unexpected character" : "move expected";
+        }
+        ++pos;
+        const bool wide = pos < size && scramble[pos] == 'w';
+        pos += wide;
+        uint8_t direction = directionCw;
+        if (pos < size && scramble[pos] == '2') {
+            direction = directionDouble;
+            ++pos;
+            if (pos < size && scramble[pos] == '\'') {
+                ++pos;
+            }
+        } else if (pos < size && scramble[pos] == '\'') {
+            direction = directionCcw;
+            ++pos;
+            if (pos < size && scramble[pos] == '2') {
+                direction = directionDouble;
+                ++pos;
+            }
+        }
+        if ((prefix || wide) && letter.kind != LetterKind::face) {
+            return "only face moves can be wide or have a layer prefix";
+        }
+        if (letter.kind == LetterKind::slice) {
+            if (face_layers.depth == 1) {
+                return "slice moves are not supported by the move set";
+            }
+            moves.push_back(letter.index + qtmMoveSetSize * direction);
+            continue;
+        }
+        // range of layers of the face, from the outside in
+        uint8_t first = 0, last = 1;
+        if (letter.kind == LetterKind::rotation) {
+            last = face_layers.depth;
+            if (last == 1) {
+                return "rotations are not supported by the move set";
+            }
+        } else if (letter.kind == LetterKind::lowercase) {
+            // r is Rw on 333, and the second layer on 555
+            first = face_layers.depth == 5 ? 1 : 0;
+            last = 2;
+        } else if (wide) {
+            last = prefix ? prefix : 2;
+        } else if (prefix) {
+            first = prefix - 1;
+            last = prefix;
+        }
+        if (last > face_layers.depth) {
+            return "move turns more layers than the move set has";
+        }
+        for (uint8_t i = first; i < last; ++i) {
+            const Layer layer = face_layers.layers[letter.index][i];
+            const uint8_t layer_direction = layer.flipped ? directionCcw - direction : direction;
+            moves.push_back(layer.index + qtmMoveSetSize * layer_direction);
+        }
+    }
+    CUBING_COUNT_N(scrambleParsedMoves, moves.size() - initial_size);
+    return nullptr;
+}
+
+} // namespace
+
+template<QtmMoveSetSize qtmMoveSetSize>
+void ScrambleParser<qtmMoveSetSize>::parse(std::string_view scramble, MovesVector<qtmMoveSetSize>& moves) {
+    size_t error_position = 0;
+    if (const char* error = parse_moves(scramble, moves, error_position)) {
+        throw ScrambleParseError(fmt::format("{} in <{}>", error, scramble), error_position);
+    }
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+MovesVector<qtmMoveSetSize> ScrambleParser<qtmMoveSetSize>::parse(std::string_view scramble) {
+    MovesVector<qtmMoveSetSize> moves;
+    moves.reserve(scramble.size() / 2 + 1);
+    parse(scramble, moves);
+    return moves;
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+size_t ScrambleParser<qtmMoveSetSize>::try_parse(std::string_view scramble, MovesVector<qtmMoveSetSize>& moves) {
+    size_t error_position = 0;
+    return parse_moves(scramble, moves, error_position) ? error_position : std::string_view::npos;
+}
+
+} // namespace cubing
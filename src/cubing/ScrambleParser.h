@@ -0,0 +1,47 @@
+#pragma once
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include "CubingDefs.h"
+#include "MovesVector.h"
+
+namespace cubing {
+
+class ScrambleParseError : public std::runtime_error {
+public:
+    ScrambleParseError(const std::string& message, size_t position);
+
+    /// @returns offset of the offending character in the parsed string
+    size_t position() const {return position_;}
+
+private:
+    size_t position_;
+};
+
+/*
+ * Single-pass parser of the standard notation: R U' F2 x y' Rw 3Rw' r M2' ... Moves may be separated by spaces or
+ * written without separators (R U'F). Amounts: none, ', 2, 2', '2 (2' and '2 are doubles). Every move is expanded
+ * into qtm layer moves of the set:
+ *   - slices M E S need sidesAndMid333 or allMoves555
+ *   - wide moves Rw (and lowercase r on 333) turn 2 layers, 3Rw turns 3 layers, etc.; 2R / 3R turn a single inner
+ *     layer, so on 555 <r> == <2R>
+ *   - rotations x y z turn all layers, so they need slices on 333
+ */
+template<QtmMoveSetSize qtmMoveSetSize>
+class ScrambleParser {
+public:
+    /// appends moves of @param scramble to @param moves
+    /// @throws ScrambleParseError if the scramble is invalid or has moves not supported by the move set
+    static void parse(std::string_view scramble, MovesVector<qtmMoveSetSize>& moves);
+    static MovesVector<qtmMoveSetSize> parse(std::string_view scramble);
+
+    /// same as parse() but doesn't throw; on error @param moves content is unspecified
+    /// @returns error position or std::string_view::npos if the scramble is valid
+    static size_t try_parse(std::string_view scramble, MovesVector<qtmMoveSetSize>& moves);
+};
+
+template class ScrambleParser<sides333>;
+template class ScrambleParser<sidesAndMid333>;
+template class ScrambleParser<allMoves555>;
+
+} // namespace cubing
@@ -1,7 +1,9 @@
 #include "ScrambleProcessing.h"
+#include "ScrambleParser.h"
 #include <strutil.h>
 #include <fmt/format.h>
 #include <numeric>
+#include <array>
 
 namespace cubing {
 
@@ -18,46 +20,189 @@ std::string inverseCycles(const std::string& cyclesString) {
     return strutil::join(cycles, ".");
 }
 
-void removeMiscChars(std::string& s) {
-    const std::string miscChars = "\".,()";
-    // remove all miscChars from string
-    for (char c : miscChars) {
-        s.erase(std::remove(s.begin(), s.end(), c), s.end());
-    }
-    // replace multiple spaces with single space
-    strutil::replace_all(s, "  ", " ");
+namespace {
+
+enum CharClass : uint8_t {
+    charOther,
+    charSpace,
+    charRemoved,   // ".,()*
+    charFace,      // RLFBDU
+    charSmall,     // rlfbdu
+    charSlice,     // SMExyz
+    charWide,      // w
+    charPrime,     // '
+    charDigit2,
+    charDigit34,
+};
+
+constexpr std::array<CharClass, 128> make_char_classes() {
+    std::array<CharClass, 128> classes{};
+    for (const char c : std::string_view(" \t\r\n")) classes[c] = charSpace;
+    for (const char c : std::string_view("\".,()*")) classes[c] = charRemoved;
+    for (const char c : std::string_view("RLFBDU")) classes[c] = charFace;
+    for (const char c : std::string_view("rlfbdu")) classes[c] = charSmall;
+    for (const char c : std::string_view("SMExyz")) classes[c] = charSlice;
+    classes['w'] = charWide;
+    classes['\''] = charPrime;
+    classes['`'] = charPrime;
+    classes['2'] = charDigit2;
+    classes['3'] = charDigit34;
+    classes['4'] = charDigit34;
+    return classes;
 }
 
-std::string normalize(const std::string& source) {
-    std::string s = strutil::trim_copy(source);
-    removeMiscChars(s);
+constexpr auto kCharClasses = make_char_classes();
+
+inline CharClass char_class(char c) {
+    return (c & 0x80) ? charOther : kCharClasses[c];
+}
+
+inline bool is_move_letter(CharClass c) {
+    return c == charFace || c == charSmall || c == charSlice;
+}
+
+/// @returns length of the UTF-8 apostrophe-like sequence at @param pos (ʼ ᾿ ՚ ’ ‘ ′), or 0
+size_t utf8_apostrophe_length(std::string_view s, size_t pos) {
+    static constexpr std::array<std::string_view, 6> kApostrophes = {
+        "\xCA\xBC", "\xE1\xBE\xBF", "\xD5\x9A", "\xE2\x80\x99", "\xE2\x80\x98", "\xE2\x80\xB2"};
+    for (const auto apostrophe : kApostrophes) {
+        if (s.substr(pos, apostrophe.size()) == apostrophe) {
+            return apostrophe.size();
+        }
+    }
+    return 0;
+}
 
-    std::string apostrophes = "ʼ᾿՚’`";
-    for (char a : apostrophes) {
-        for (char& c : s) {
-            c = (c == a) ? '\'' : c;
+} // namespace
+
+std::string normalize(std::string_view source) {
+    // move: [234]? letter w? amount, where amount is any of ' 2 '2 2'
+    enum State : uint8_t {betweenMoves, afterPrefix, afterLetter, afterAmount, afterOther};
+    std::string result;
+    result.reserve(source.size());
+    State state = betweenMoves;
+    bool pending_space = false;
+    const auto separate = [&]() {
+        if (!result.empty()) {
+            result.push_back(' '); // trims, collapses spaces and splits spliced moves like U'D
+        }
+        pending_space = false;
+    };
+    const auto class_at = [&](size_t pos) {return pos < source.size() ? char_class(source[pos]) : charSpace;};
+
+    for (size_t pos = 0; pos < source.size(); ++pos) {
+        const char c = source[pos];
+        CharClass cls = char_class(c);
+        if (const size_t length = (cls == charOther) ? utf8_apostrophe_length(source, pos) : 0; length > 0) {
+            cls = charPrime;
+            pos += length - 1;
+        }
+        switch (cls) {
+            case charSpace:
+                pending_space = true;
+                state = betweenMoves;
+                break;
+            case charRemoved:
+                break;
+            case charFace: case charSmall: case charSlice:
+                if (state == betweenMoves || state == afterLetter || state == afterAmount) {
+                    separate();
+                }
+                result.push_back(c);
+                state = (state == afterOther) ? afterOther : afterLetter;
+                break;
+            case charWide:
+                result.push_back(c);
+                state = (state == afterLetter) ? afterLetter : afterOther;
+                break;
+            case charPrime:
+                if (state == afterAmount && result.back() == '2') {
+                    break; // R2' -> R2
+                }
+                if (state == betweenMoves) {
+                    separate();
+                }
+                result.push_back('\'');
+                state = (state == afterLetter || state == afterAmount) ? afterAmount : afterOther;
+                break;
+            case charDigit2: case charDigit34: {
+                if (cls == charDigit2 && state == afterAmount && result.back() == '\'') {
+                    result.back() = '2'; // R'2 -> R2
+                    break;
+                }
+                const bool starts_move = is_move_letter(class_at(pos + 1));
+                if ((state == afterLetter && (cls == charDigit2 || !starts_move))
+                    || (state == afterAmount && !starts_move)) {
+                    result.push_back(c);
+                    state = afterAmount;
+                    break;
+                }
+                if (state == afterPrefix || state == afterOther) {
+                    result.push_back(c);
+                    state = afterOther;
+                    break;
+                }
+                separate(); // new move: between moves, or spliced like U2 3Rw
+                state = afterPrefix;
+                if (cls == charDigit2 && class_at(pos + 1) == charFace && class_at(pos + 2) == charWide) {
+                    break; // 2Rw -> Rw
+                }
+                result.push_back(c);
+                break;
+            }
+            default:
+                if (state == betweenMoves) {
+                    separate();
+                }
+                result.push_back(c);
+                state = afterOther;
+                break;
         }
     }
+    return result;
+}
 
-    // replace "r'2 to r2"
-    strutil::replace_all(s, "'2", "2");
-    return s;
+MoveNotation classifyMove(std::string_view m) {
+    // [34]? letter w? ['2]?
+    size_t pos = 0;
+    const bool prefixed = !m.empty() && char_class(m[0]) == charDigit34;
+    pos += prefixed;
+    const CharClass letter = pos < m.size() ? char_class(m[pos]) : charOther;
+    ++pos;
+    const bool wide = pos < m.size() && m[pos] == 'w';
+    pos += wide;
+    if (pos < m.size() && (m[pos] == '\'' || m[pos] == '2')) {
+        ++pos;
+    }
+    if (pos != m.size()) {
+        return MoveNotation::invalid;
+    }
+    switch (letter) {
+        case charFace:
+            return !prefixed ? MoveNotation::cube : wide ? MoveNotation::cube34 : MoveNotation::invalid;
+        case charSmall:
+            return (prefixed || wide) ? MoveNotation::invalid : MoveNotation::smallCube;
+        case charSlice:
+            return (prefixed || wide) ? MoveNotation::invalid : MoveNotation::sliceOrRotation;
+        default:
+            return MoveNotation::invalid;
+    }
 }
 
 bool is34CubeMove(const std::string& m) {
-    return std::regex_search(m, std::regex{"^[34][RLFBDU]w[\'2]?$"});
+    return classifyMove(m) == MoveNotation::cube34;
 }
 
 bool isCubeMove(const std::string& m) {
-    return std::regex_search(m, std::regex{"^[RLFBDU]w?[\'2]?$"});
+    return classifyMove(m) == MoveNotation::cube;
 }
 
 bool isSmallCubeMove(const std::string& m) {
-    return std::regex_search(m, std::regex{"^[rlfbdu][\'2]?$"});
+    return classifyMove(m) == MoveNotation::smallCube;
 }
 
 bool isSliceCubeMove(const std::string& m) {
-    return std::regex_search(m, std::regex{"^[SMExyz][\'2]?$"});
+    return classifyMove(m) == MoveNotation::sliceOrRotation;
 }
 
 std::string invertScramble(const std::string& scramble) {
@@ -202,76 +347,39 @@ std::string front2back(const std::string& alg) {
     return mirrorAlg(alg, f2bMap);
 }
 
-std::string scrambleTearApart333(const std::string& input_alg) {
-    std::string alg = input_alg;
-    strutil::replace_all(alg, "2'", "2");
-    strutil::replace_all(alg, "'2", "2");
-    strutil::replace_all(alg, "3", "'");
-
-    strutil::replace_all(alg, "Rw", "r");
-    strutil::replace_all(alg, "Lw", "l");
-    strutil::replace_all(alg, "Fw", "f");
-    strutil::replace_all(alg, "Bw", "b");
-    strutil::replace_all(alg, "Uw", "u");
-    strutil::replace_all(alg, "Dw", "d");
-
-    strutil::replace_all(alg, "r2", "R2 M2");
-    strutil::replace_all(alg, "r\'", "R\' M");
-    strutil::replace_all(alg, "r", "R M\'");
-
-    strutil::replace_all(alg, "l2", "L2 M2");
-    strutil::replace_all(alg, "l\'", "L\' M\'");
-    strutil::replace_all(alg, "l", "L M");
-
-    strutil::replace_all(alg, "u2", "U2 E2");
-    strutil::replace_all(alg, "u\'", "U\' E");
-    strutil::replace_all(alg, "u", "U E\'");
-
-    strutil::replace_all(alg, "d2", "D2 E2");
-    strutil::replace_all(alg, "d\'", "D\' E\'");
-    strutil::replace_all(alg, "d", "D E");
-
-    strutil::replace_all(alg, "f2", "F2 S2");
-    strutil::replace_all(alg, "f\'", "F\' S\'");
-    strutil::replace_all(alg, "f", "F S");
+std::string scrambleTearApart333(const std::string& alg) {
+    return ScrambleParser<sidesAndMid333>::parse(alg).to_string();
+}
 
-    strutil::replace_all(alg, "b2", "B2 B2");
-    strutil::replace_all(alg, "b\'", "B\' S");
-    strutil::replace_all(alg, "b", "B S\'");
+std::string scrambleGlueMoves333(const std::string& alg) {
+    return ScrambleParser<sidesAndMid333>::parse(alg).to_string_combined_moves();
+}
 
-    return alg;
+static constexpr std::array<uint16_t, 128> make_move_scores() {
+    std::array<uint16_t, 128> scores{}; // 0 = unknown move
+    constexpr std::pair<char, uint16_t> kScores[] = {
+        {'R', 100}, {'U', 100}, {'F', 130}, {'L', 110}, {'D', 120}, {'B', 150},
+        {'M', 120}, {'E', 150}, {'S', 150},
+        {'r', 120}, {'u', 120}, {'f', 160}, {'l', 130}, {'d', 140}, {'b', 170},
+        {'x', 145}, {'y', 150}, {'z', 150},
+    };
+    for (const auto& [letter, score] : kScores) {
+        scores[letter] = score;
+    }
+    return scores;
 }
 
-static std::unordered_map<char, uint32_t> move_scores = {
-    {'R', 100},
-    {'U', 100},
-    {'F', 130},
-    {'L', 110},
-    {'D', 120},
-    {'B', 150},
-    {'M', 120},
-    {'E', 150},
-    {'S', 150},
-    {'r', 120},
-    {'u', 120},
-    {'f', 160},
-    {'l', 130},
-    {'d', 140},
-    {'b', 170},
-    {'x', 145},
-    {'y', 150},
-    {'z', 150},
-};
+static constexpr auto kMoveScores = make_move_scores();
 
 uint32_t execution_convenience_score_of_move(std::string_view move) {
     if (move.empty()) {
         throw std::runtime_error("execution_convenience_score: empty string");
     }
-    const auto itr = move_scores.find(move.front());
-    if (itr == move_scores.end()) {
+    const uint32_t base_score = (move.front() & 0x80) ? 0 : kMoveScores[move.front()];
+    if (base_score == 0) {
         throw std::runtime_error(fmt::format("execution_convenience_score: unknown move string <{}>", move));
     }
-    uint32_t base_score = itr->second, wide_penalty = 0, double_penalty = 0;
+    uint32_t wide_penalty = 0, double_penalty = 0;
     if (move.size() > 1 && move[1] == 'w') {
         wide_penalty = 15 + (base_score - 100) / 2; // R=100 => Rw=115; B=150 => Bw=150+15+25=190
     }
@@ -298,49 +406,6 @@ uint32_t execution_convenience_score(const std::string& alg) {
 }
 
 
-/*
-std::string scrambleGlueMoves333(const std::string& suboptimal_alg) {
-    auto alg = suboptimal_alg;
-    alg = std::regex_replace(alg, std::regex("R2 M2 L2"), "x2");
-    alg = std::regex_replace(alg, std::regex("R M' L'"), "x");
-    alg = std::regex_replace(alg, std::regex("R' M L(?=\\s|$)"), "x'");
-
-    alg = std::regex_replace(alg, std::regex("U2 E2 D2"), "y2");
-    alg = std::regex_replace(alg, std::regex("U E' D'"), "y");
-    alg = std::regex_replace(alg, std::regex("U' E D(?=\\s|$)"), "y'");
-
-    alg = std::regex_replace(alg, std::regex("F2 S2 B2"), "z2");
-    alg = std::regex_replace(alg, std::regex("F S B'"), "z");
-    alg = std::regex_replace(alg, std::regex("F' S' B(?=\\s|$)"), "z'");
-
-    alg = std::regex_replace(alg, std::regex("R2 M2"), "Rw2");
-    alg = std::regex_replace(alg, std::regex("R M'"), "Rw");
-    alg = std::regex_replace(alg, std::regex("R' M(?=\\s|$)"), "Rw'");
-
-    alg = std::regex_replace(alg, std::regex("L2 M2"), "Lw2");
-    alg = std::regex_replace(alg, std::regex("L' M'"), "Lw'");
-    alg = std::regex_replace(alg, std::regex("L M(?=\\s|$)"), "Lw");
-
-    alg = std::regex_replace(alg, std::regex("U2 E2"), "Uw2");
-    alg = std::regex_replace(alg, std::regex("U' E(?=\\s|$)"), "Uw'");
-    alg = std::regex_replace(alg, std::regex("U E'"), "Uw");
-
-    alg = std::regex_replace(alg, std::regex("F2 S2"), "Fw2");
-    alg = std::regex_replace(alg, std::regex("F' S'"), "Fw'");
-    alg = std::regex_replace(alg, std::regex("F S(?=\\s|$)"), "Fw");
-
-    // Replace wide move notations
-    alg = std::regex_replace(alg, std::regex("B' S(?=\\s|$)"), "Bw'");
-    alg = std::regex_replace(alg, std::regex("B S'"), "Bw");
-    alg = std::regex_replace(alg, std::regex("B2 S2"), "Bw2");
-
-    alg = std::regex_replace(alg, std::regex("D E(?=\\s|$)"), "Dw");
-    alg = std::regex_replace(alg, std::regex("D' E'"), "Dw'");
-    alg = std::regex_replace(alg, std::regex("D2 E2"), "Dw2");
-    return alg;
-}
-*/
-
 /*
 void scrambleTearApart555(std::string& alg) {
     alg = alg.replace("2\'", "2").replace("\'2", "2");
@@ -1,12 +1,26 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace cubing {
 
-// delete double spaces, replace apostrophes. R`  U -> R' U
-std::string normalize(const std::string &source);
+// delete double spaces and misc chars (".,()*), replace apostrophes, split spliced moves. R`  (U'D) -> R' U' D.
+// Also R'2 -> R2 and 2Rw -> Rw. Parentheses are only stripped: group repetition like (R U)2 is not expanded, and the
+// count is applied to the last move of the group, so such algs must be expanded before normalizing.
+std::string normalize(std::string_view source);
+
+enum class MoveNotation : uint8_t {
+    invalid,
+    cube,           // R, Rw', U2, ...
+    smallCube,      // r, u', ...
+    sliceOrRotation,// M, S', x2, ...
+    cube34,         // 3Rw, 4Uw2, ...
+};
+
+/// \returns notation class of a single normalized move \param m
+MoveNotation classifyMove(std::string_view m);
 
 /// \returns true if \param m is side-move (R,U,L,D,B,F), R', U', ..., R2, U2, ..., F2.
 bool isCubeMove(const std::string &m);
@@ -40,15 +54,22 @@ std::string left2right(const std::string& alg);
 /// converts algorithm front-to-back
 std::string front2back(const std::string& alg);
 
-/// replace moves like 'r' "R M'" etc.
+/// replaces wide moves and rotations with side and slice moves: r -> R M', x -> R M' L' etc.
+/// @throws ScrambleParseError (runtime_error) if the alg isn't a valid 333 alg
 std::string scrambleTearApart333(const std::string& alg);
 
+/// replaces side and slice moves with wide moves and rotations where possible: R M' -> Rw, R M' L' -> x etc.
+/// @throws ScrambleParseError (runtime_error) if the alg isn't a valid 333 alg
+std::string scrambleGlueMoves333(const std::string& alg);
+
 
 /// @returns convenience score - lower is better. /// @param moves could include wide moves (Rw, ...) and cube rotations
+/// See also ConvenienceScorer for scoring MovesVector without building strings.
 uint32_t execution_convenience_score(const std::string& alg);
 
-/// \replace moves like 'r' "R M'" etc.
-//std::string scrambleGlueMoves333(const std::string& scramble);
+/// @returns convenience score of a single move, e.g. Rw'
+uint32_t execution_convenience_score_of_move(std::string_view move);
+
 /*
 /// \replace moves like '3Rw' with "Rw M'" etc.
 void scrambleTearApart555(std::string& scramble);
@@ -65,9 +86,6 @@ void scrambleReplaceRotations333(std::string& scramble);
 /// inverses cycles in cyclesString. Example: "UF-UL-UR" -> "UR-UL-UF"
 std::string inverseCycles(const std::string& cyclesString);
 
-/// tear apart spliced moves (U'D'), replaces '2 with 2
-std::string fixStupidInputHabits(std::string alg);
-
 */
 
 } // namespace cubing
\ No newline at end of file
@@ -0,0 +1,158 @@
+#include "Tracing.h"
+#include "Helpers.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <vector>
+#include <fmt/format.h>
+
+namespace cubing {
+
+namespace {
+
+struct TraceEvent {
+    std::string name;
+    uint32_t thread_id;
+    int64_t start_us;
+    int64_t duration_us; // -1 for thread name metadata
+};
+
+std::atomic<bool> g_tracing_enabled{false};
+
+uint32_t current_thread_id() {
+    static std::atomic<uint32_t> next_thread_id{1};
+    thread_local const uint32_t thread_id = next_thread_id.fetch_add(1);
+    return thread_id;
+}
+
+std::string escape_json(const std::string& s) {
+    std::string result;
+    result.reserve(s.size());
+    for (const char c : s) {
+        if (c == '"' || c == '\\') {
+            result += '\\';
+        }
+        result += c;
+    }
+    return result;
+}
+
+class Tracer {
+public:
+    static Tracer& instance() {
+        static Tracer tracer;
+        return tracer;
+    }
+    ~Tracer() {
+        flush();
+    }
+
+    int64_t now_us() const {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_).count();
+    }
+
+    void start(const std::string& path) {
+        std::lock_guard lock(mutex_);
+        path_ = path;
+    }
+
+    void stop() {
+        flush();
+        std::lock_guard lock(mutex_);
+        path_.clear();
+        events_.clear();
+    }
+
+    void add(TraceEvent&& event) {
+        std::lock_guard lock(mutex_);
+        events_.push_back(std::move(event));
+    }
+
+    bool flush() {
+        std::lock_guard lock(mutex_);
+        if (path_.empty()) {
+            return true;
+        }
+        std::string json = "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+        for (size_t i = 0; i < events_.size(); ++i) {
+            const auto& e = events_[i];
+            json += e.duration_us < 0
+                ? fmt::format(R"(  {{"name": "thread_name", "ph": "M", "pid": 1, "tid": {}, "args": {{"name": "{}"}}}})",
+                              e.thread_id, escape_json(e.name))
+                : fmt::format(R"(  {{"name": "{}", "cat": "cubing", "ph": "X", "pid": 1, "tid": {}, "ts": {}, "dur": {}}})",
+                              escape_json(e.name), e.thread_id, e.start_us, e.duration_us);
+            json += i + 1 < events_.size() ? ",\n" : "\n";
+        }
+        json += "]}\n";
+        return saveToFile(path_, json);
+    }
+
+private:
+    Tracer() : start_(std::chrono::steady_clock::now()) {}
+
+    const std::chrono::steady_clock::time_point start_;
+    std::mutex mutex_;
+    std::string path_;
+    std::vector<TraceEvent> events_;
+};
+
+[[maybe_unused]] const bool g_started_from_env = [] {
+    if (const char* path = std::getenv("CUBING_TRACE"); path && *path) {
+        start_tracing(path);
+        set_trace_thread_name("main");
+        return true;
+    }
+    return false;
+}();
+
+} // namespace
+
+bool tracing_enabled() {
+    return g_tracing_enabled.load(std::memory_order_relaxed);
+}
+
+void start_tracing(const std::string& path) {
+    Tracer::instance().start(path);
+    g_tracing_enabled = true;
+}
+
+void stop_tracing() {
+    g_tracing_enabled = false;
+    Tracer::instance().stop();
+}
+
+bool flush_trace() {
+    return Tracer::instance().flush();
+}
+
+void set_trace_thread_name(const std::string& name) {
+    if (tracing_enabled()) {
+        Tracer::instance().add({name, current_thread_id(), 0, -1});
+    }
+}
+
+TraceSpan::TraceSpan(const char* name) {
+    if (tracing_enabled()) {
+        name_ = name;
+        start_us_ = Tracer::instance().now_us();
+    }
+}
+
+TraceSpan::TraceSpan(std::string name) {
+    if (tracing_enabled()) {
+        owned_name_ = std::move(name);
+        start_us_ = Tracer::instance().now_us();
+    }
+}
+
+TraceSpan::~TraceSpan() {
+    if (start_us_ < 0 || !tracing_enabled()) {
+        return;
+    }
+    auto& tracer = Tracer::instance();
+    tracer.add({name_ ? std::string(name_) : std::move(owned_name_), current_thread_id(), start_us_,
+                tracer.now_us() - start_us_});
+}
+
+} // namespace cubing
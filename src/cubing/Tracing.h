@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+namespace cubing {
+
+/*
+ * Phase tracing in the trace event format (load the file in chrome://tracing or ui.perfetto.dev). Tracing starts at
+ * program start if the CUBING_TRACE environment variable holds an output path, or with start_tracing(). The file is
+ * written at exit and by flush_trace().
+ *
+ * Spans are meant for phases (load, parse, merge, explore batches, save), not for per-move work: when tracing is
+ * off, a span costs a single flag check.
+ */
+
+bool tracing_enabled();
+
+/// starts collecting spans, to be written to @param path
+void start_tracing(const std::string& path);
+/// writes collected spans and stops collecting; spans collected later go to the path of the next start_tracing()
+void stop_tracing();
+/// writes spans collected so far, e.g. at checkpoints of long runs. @returns false if the file couldn't be written
+bool flush_trace();
+
+/// names the calling thread in the trace, e.g. "worker 3"
+void set_trace_thread_name(const std::string& name);
+
+/// records the time between its construction and destruction as a span of the calling thread
+class TraceSpan {
+public:
+    explicit TraceSpan(const char* name);
+    explicit TraceSpan(std::string name); // for names built at runtime, e.g. "depth 7"
+    ~TraceSpan();
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    const char* name_{nullptr};
+    std::string owned_name_;
+    int64_t start_us_{-1}; // -1 if tracing was off when the span started
+};
+
+#define CUBING_TRACE_CONCAT_IMPL(a, b) a##b
+#define CUBING_TRACE_CONCAT(a, b) CUBING_TRACE_CONCAT_IMPL(a, b)
+/// traces the rest of the enclosing scope
+#define CUBING_TRACE_SPAN(name) ::cubing::TraceSpan CUBING_TRACE_CONCAT(trace_span_, __LINE__)(name)
+
+} // namespace cubing
@@ -0,0 +1,70 @@
+#include <iostream>
+#include <fstream>
+#include "cubing/CubingDefs.h"
+#include "cubing/ScrambleEvaluation.h"
+#include <strutil.h>
+#include <thread>
+
+using namespace cubing;
+
+static void print_usage_and_exit(const char* program) {
+    std::cerr << "usage: " << program << " [--moves sides333|sidesAndMid333|allMoves555] [--fields state,top,front,mosaic]"
+              << " [--format tsv|binary] [--threads N] [/path/to/scrambles.txt]\n"
+              << "Reads one scramble per line from the file or stdin, writes records to stdout in input order" << std::endl;
+    exit(-1);
+}
+
+int main(int argc, char** argv) {
+    std::string move_set = "sidesAndMid333";
+    std::string input_path;
+    ScrambleEvaluationOptions options;
+    options.num_threads = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "--moves" && has_value) {
+            move_set = argv[++i];
+        } else if (arg == "--fields" && has_value) {
+            options.fields.clear();
+            for (const auto& field : strutil::split(argv[++i], ',')) {
+                options.fields.push_back(evaluation_field_from_string(field));
+            }
+        } else if (arg == "--format" && has_value) {
+            const std::string format = argv[++i];
+            if (format != "tsv" && format != "binary") {
+                print_usage_and_exit(argv[0]);
+            }
+            options.format = format == "tsv" ? EvaluationOutputFormat::tsv : EvaluationOutputFormat::binary;
+        } else if (arg == "--threads" && has_value) {
+            options.num_threads = std::stoul(argv[++i]);
+        } else if (arg.starts_with("--") || !input_path.empty()) {
+            print_usage_and_exit(argv[0]);
+        } else {
+            input_path = arg;
+        }
+    }
+
+    std::ifstream file;
+    if (!input_path.empty() && input_path != "-") {
+        file.open(input_path);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open " << input_path << std::endl;
+            return -1;
+        }
+    }
+    std::istream& in = file.is_open() ? file : std::cin;
+    std::ios::sync_with_stdio(false);
+
+    size_t num_evaluated = 0;
+    if (move_set == "sides333") {
+        num_evaluated = evaluate_scrambles<sides333>(in, std::cout, options);
+    } else if (move_set == "sidesAndMid333") {
+        num_evaluated = evaluate_scrambles<sidesAndMid333>(in, std::cout, options);
+    } else if (move_set == "allMoves555") {
+        num_evaluated = evaluate_scrambles<allMoves555>(in, std::cout, options);
+    } else {
+        print_usage_and_exit(argv[0]);
+    }
+    std::cerr << "Evaluated " << num_evaluated << " scrambles" << std::endl;
+    return 0;
+}
@@ -5,15 +5,20 @@
 #include "cubing/ScrambleProcessing.h"
 #include "cubing/IterativeScramble.h"
 #include "cubing/Helpers.h"
+#include "cubing/FacePatternPredicate.h"
+#include "cubing/FinderTelemetry.h"
+#include "cubing/ReachablePatterns.h"
+#include "cubing/Counters.h"
+#include "cubing/Tracing.h"
 #include <fmt/format.h>
 #include <csignal>
 #include <filesystem>
+#include <optional>
 
 using namespace cubing;
 
 static volatile bool exit_flag = false;
 static constexpr QtmMoveSetSize QTM_MOVE_SET_SIZE = QtmMoveSetSize::sidesAndMid333; // change to sides333 if needed
-static constexpr size_t NUM_STICKERS = 9; // change to NUM_STICKERS_ON_ONE_SIDE if aiming for 8-sticker mode
 static constexpr size_t NUM_COLORS_IN_CUBE = 6;
 
 static const auto now = [] { return std::chrono::steady_clock::now(); };
@@ -28,6 +33,12 @@ static IterativeScramble<QTM_MOVE_SET_SIZE> loadScrambleFromFile(const std::stri
     return IterativeScramble<QTM_MOVE_SET_SIZE>::from_moves(moves);
 }
 
+static void saveStats(const std::string& working_dir, const FinderTelemetry& telemetry) {
+    if (!telemetry.save_to_file(fmt::format("{}/{}", working_dir, STATS_FILE_NAME))) {
+        std::cout << "Failed to save stats to " << working_dir << "/" << STATS_FILE_NAME << std::endl;
+    }
+}
+
 static void saveProgress(const std::string& working_dir, const PatternToAlgAndConvenienceMap& map,
                          const IterativeScramble<QTM_MOVE_SET_SIZE>& scramble) {
     if (!map.save_to_file(fmt::format("{}/{}", working_dir, ALGS_FILE_NAME))) {
@@ -35,14 +46,20 @@ static void saveProgress(const std::string& working_dir, const PatternToAlgAndCo
         exit(-1);
     }
     saveToFile(fmt::format("{}/{}", working_dir, SCRAMBLE_FILE_NAME), scramble.get().to_string());
+    flush_trace();
 }
 
 int main(int argc, char** argv) {
-    if (argc < 2 || !std::filesystem::is_directory(argv[1])) {
-        std::cerr << "usage: " << argv[0] << " /path/to/working_dir" << std::endl;
+    if (argc < 2 || argc > 3 || !std::filesystem::is_directory(argv[1])) {
+        std::cerr << "usage: " << argv[0] << " /path/to/working_dir [/path/to/predicate_spec]" << std::endl;
+        std::cerr << "without a predicate spec, searches for F and B with the same pattern with opposite colors:\n"
+                  << TWO_SIDED_MOSAIC_PREDICATE << std::endl;
         exit(-1);
     }
     const auto working_dir = argv[1];
+    // e.g. "key F8" searches for 8-sticker patterns, ignoring centers
+    const auto predicate = argc == 3 ? FacePatternPredicate<QTM_MOVE_SET_SIZE>::load_from_file(argv[2])
+                                     : FacePatternPredicate<QTM_MOVE_SET_SIZE>::compile(TWO_SIDED_MOSAIC_PREDICATE);
     auto scramble = loadScrambleFromFile(fmt::format("{}/{}", working_dir, SCRAMBLE_FILE_NAME));
     auto patternToAlgAndConvenience = PatternToAlgAndConvenienceMap::load_from_file(fmt::format("{}/{}", working_dir, ALGS_FILE_NAME));
 
@@ -50,40 +67,114 @@ int main(int argc, char** argv) {
         std::signal(sig, [](int) { exit_flag = true; });
     }
 
-    const size_t totalPatterns = std::pow(NUM_COLORS_IN_CUBE, NUM_STICKERS); // each of 6 colors of the cube must be taken by every sticker
+    const bool default_spec = argc == 2;
+    size_t totalPatterns = std::pow(NUM_COLORS_IN_CUBE, predicate.num_key_stickers()); // each of 6 colors of the cube must be taken by every sticker
+    // default search: count coverage of the reachable patterns, if compute_reachable_patterns saved them
+    const auto reachable_path = fmt::format("{}/{}", working_dir, REACHABLE_PATTERNS_FILE_NAME);
+    if (default_spec && std::filesystem::exists(reachable_path)) {
+        totalPatterns = PatternBitmap::load_from_file(reachable_path).count();
+        std::cout << "Loaded " << totalPatterns << " reachable patterns from " << reachable_path << std::endl;
+    }
     auto last_hit_made = now();
     std::string latest_found_alg;
     uint64_t counter{0}, num_hits{0};
+    FinderTelemetry telemetry;
+    const auto update_telemetry = [&] {
+        telemetry.update(scramble.size(), scramble.progress_fraction(), patternToAlgAndConvenience.size(),
+                         totalPatterns);
+    };
+    // one trace span per alg size, as precise as the reporting interval
+    std::optional<TraceSpan> depth_span;
+    size_t traced_depth = 0;
+    const auto update_depth_span = [&] {
+        if (tracing_enabled() && scramble.size() != traced_depth) {
+            traced_depth = scramble.size();
+            depth_span.reset();
+            depth_span.emplace(fmt::format("depth {}", traced_depth));
+        }
+    };
+    update_depth_span();
+    using HitSource = FinderTelemetry::HitSource;
+    const auto record_hit = [&](const std::string& pattern, const MovesVector<QTM_MOVE_SET_SIZE>& moves,
+                                HitSource source) {
+        const bool improved = patternToAlgAndConvenience.insert_if_more_convenient(pattern, moves);
+        telemetry.on_hit(improved, source);
+        if (improved) {
+            ++num_hits;
+            last_hit_made = now();
+            latest_found_alg = patternToAlgAndConvenience.get().at(pattern).alg;
+        }
+    };
+    // the default search also checks R/L and U/D of each state: a mosaic there is an F/B mosaic of the same moves
+    // performed on a rotated cube, so it's recorded for those. Hits are rare, so applying them again is cheap.
+    const auto right_left = FacePatternPredicate<QTM_MOVE_SET_SIZE>::compile("opposite R L");
+    const auto up_down = FacePatternPredicate<QTM_MOVE_SET_SIZE>::compile("opposite U D");
+    const auto record_rotated_hit = [&](const MovesVector<QTM_MOVE_SET_SIZE>& rotated, HitSource source) {
+        const auto moves = rotated.canonicalized();
+        CubeState<QTM_MOVE_SET_SIZE> rotated_cube;
+        rotated_cube.applyScramble(moves);
+        record_hit(predicate.key(rotated_cube), moves, source);
+    };
+    // checks @param state for all predicates; @param get_moves builds its moves, which is only needed for hits.
+    // Hits of the inverse state are all counted as inverse hits, see FinderTelemetry
+    // @returns true if any predicate matched
+    const auto check_state = [&](const CubeState<QTM_MOVE_SET_SIZE>& state, const auto& get_moves, bool inverse) {
+        bool hit = false;
+        if (predicate.matches(state)) {
+            record_hit(predicate.key(state), get_moves(), inverse ? HitSource::inverse : HitSource::candidate);
+            hit = true;
+        }
+        const auto rotated_source = inverse ? HitSource::inverse : HitSource::rotated;
+        if (default_spec && right_left.matches(state)) {
+            record_rotated_hit(get_moves().right2front(), rotated_source);
+            hit = true;
+        }
+        if (default_spec && up_down.matches(state)) {
+            record_rotated_hit(get_moves().up2front(), rotated_source);
+            hit = true;
+        }
+        return hit;
+    };
     while (!exit_flag) {
         CubeState<QTM_MOVE_SET_SIZE> cube;
         cube.applyScramble(scramble.get());
-        if (cube.doFrontAndBackSidesHaveSamePatternWithOppositeColors()) {
-            const auto pattern = cube.frontSideStickers();
-            const auto alg = scramble.get().to_string_combined_moves();
-            if (patternToAlgAndConvenience.insert_if_more_convenient(pattern, alg)) {
-                ++num_hits;
-                last_hit_made = now();
-                latest_found_alg = alg;
-            }
+        telemetry.on_candidate(scramble.size());
+        if (check_state(cube, [&] {return scramble.get();}, false)) {
+            // the inverse alg has the same size, so the scramble reaches it at this depth anyway; checking it along
+            // with the hit finds its pattern earlier, and compiling the alg is cheap since hits are rare past the first
+            // few depths
+            CubeState<QTM_MOVE_SET_SIZE> inverse_cube;
+            inverse_cube.applyInversePermutation(CubeState<QTM_MOVE_SET_SIZE>::compileAlgorithm(scramble.get()));
+            check_state(inverse_cube, [&] {return scramble.get().inverted().canonicalized();}, true);
         }
 
         ++scramble;
         ++counter;
 
         if (counter % 1'000'000 == 0) {
+            update_telemetry();
+            update_depth_span();
+            saveStats(working_dir, telemetry);
             std::cout << (patternToAlgAndConvenience.size() == totalPatterns ? "FOUND ALL " : "Found ")
                       << patternToAlgAndConvenience.size() << " of " << totalPatterns
                       << ", " << scramble.progress() << " | " << num_hits << " hits, last "
                       << std::chrono::duration_cast<std::chrono::seconds>(now() - last_hit_made).count()
-                      << "s ago: " << latest_found_alg << std::endl;
+                      << "s ago: " << latest_found_alg << " | " << telemetry.summary() << std::endl;
+            if (patternToAlgAndConvenience.size() >= totalPatterns) {
+                std::cout << "All patterns found, stopping" << std::endl;
+                exit_flag = true;
+            }
         }
         if (counter % 100'000'000 == 0) {
             std::cout << "Saving progress to " << working_dir << "..." << std::endl;
             saveProgress(working_dir, patternToAlgAndConvenience, scramble);
-            std::cout << "Saved, resuming search" << std::endl;
+            std::cout << counters_report() << "Saved, resuming search" << std::endl;
         }
     }
+    depth_span.reset();
     std::cout << "Saving to " << working_dir << " and exiting..." << std::endl;
     saveProgress(working_dir, patternToAlgAndConvenience, scramble);
+    update_telemetry();
+    saveStats(working_dir, telemetry);
     std::cout << "Done";
 }
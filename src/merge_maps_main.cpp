@@ -3,6 +3,7 @@
 #include "cubing/MosaicDefs.h"
 #include "cubing/Helpers.h"
 #include "cubing/ScrambleProcessing.h"
+#include "cubing/Tracing.h"
 #include <fmt/format.h>
 #include <filesystem>
 
@@ -43,6 +44,7 @@ int main(int argc, char** argv) {
             continue;
         }
         std::cout << "Loaded " << partial_map.size() << " algs, merging..." << std::endl;
+        CUBING_TRACE_SPAN("merge");
         size_t hits = 0;
         for (const auto& [pattern, suboptimal_alg_and_score] : partial_map.get()) {
             auto optimized_alg = scrambleGlueMoves333(suboptimal_alg_and_score.alg);
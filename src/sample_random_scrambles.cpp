@@ -0,0 +1,50 @@
+#include <iostream>
+#include "cubing/CubingDefs.h"
+#include "cubing/CubeState.h"
+#include "cubing/RandomScramble.h"
+#include <fmt/format.h>
+#include <chrono>
+#include <cmath>
+#include <string>
+
+using namespace cubing;
+
+static constexpr QtmMoveSetSize QTM_MOVE_SET_SIZE = QtmMoveSetSize::sidesAndMid333; // same as the finder
+
+/// Estimates how many two-sided mosaic hits a depth has before committing the finder to it: samples random canonical
+/// sequences of the depth and counts the ones with same front and back patterns. With --print, prints the sequences.
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "usage: " << argv[0] << " depth num_samples [seed] [--print]" << std::endl;
+        exit(-1);
+    }
+    const size_t depth = std::stoul(argv[1]);
+    const size_t num_samples = std::stoul(argv[2]);
+    const uint64_t seed = (argc > 3) ? std::stoull(argv[3]) : std::chrono::steady_clock::now().time_since_epoch().count();
+    const bool print = (argc > 4) && std::string(argv[4]) == "--print";
+
+    RandomScramble<QTM_MOVE_SET_SIZE> random(seed);
+    MovesVector<QTM_MOVE_SET_SIZE> moves;
+    size_t num_hits = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < num_samples; ++i) {
+        random.next(depth, moves);
+        CubeState<QTM_MOVE_SET_SIZE> cube;
+        cube.applyScramble(moves);
+        num_hits += cube.doFrontAndBackSidesHaveSamePatternWithOppositeColors();
+        if (print) {
+            std::cout << moves.to_string() << '\n';
+        }
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const double hit_rate = double(num_hits) / std::max<size_t>(num_samples, 1);
+    const double std_error = std::sqrt(hit_rate * (1 - hit_rate) / std::max<size_t>(num_samples, 1));
+    const double log10_num_sequences = random.log10_num_sequences(depth);
+    std::cerr << fmt::format("depth {}, seed {}: {} hits of {} samples, hit rate {:.3e} +- {:.1e}\n", depth, seed,
+                             num_hits, num_samples, hit_rate, std_error)
+              << fmt::format("{:.3e} canonical sequences, ~{:.3e} hits in total\n", std::pow(10., log10_num_sequences),
+                             hit_rate * std::pow(10., log10_num_sequences))
+              << fmt::format("{:.2f}M samples/s\n", num_samples / std::max(seconds, 1e-9) / 1e6);
+    return 0;
+}
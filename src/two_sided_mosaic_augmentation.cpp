@@ -3,62 +3,84 @@
 #include "cubing/MosaicDefs.h"
 #include "cubing/CubeState.h"
 #include "cubing/ScrambleProcessing.h"
+#include "cubing/MosaicAugmentation.h"
+#include "cubing/ReachablePatterns.h"
+#include "cubing/Counters.h"
+#include "cubing/Tracing.h"
 #include <fmt/format.h>
+#include <chrono>
+#include <filesystem>
+#include <thread>
 
 using namespace cubing;
 
 /*
  * Having 8-sticker 2-sided mosaic algs map (OYYWGGRRB \t  D F R' F U F D L' F L B2), augment it with new algs to
- * hopefully find algs for all 6^8 = 1'679'616 patterns.
+ * hopefully find algs for all 6^8 = 1'679'616 patterns. With max_rounds > 1, algs found in one round are explored
+ * in the next one, until no new algs are found.
  * */
 
+static void print_usage_and_exit(const char* program) {
+    std::cerr << "usage: " << program << " /path/to/algs.txt [num_threads] [max_rounds] [--half-turn-subgroup]"
+              << " [--half-turn-subgroup-step=N]\n"
+              << "  --half-turn-subgroup-step=N  try only every N-th half turn subgroup state, for quick runs; implies"
+              << " --half-turn-subgroup" << std::endl;
+    exit(-1);
+}
+
 int main(int argc, char** argv) {
-    if (argc < 2) {
-        std::cerr << "usage: " << argv[0] << " /path/to/algs.txt" << std::endl;
-        exit(-1);
+    const auto parse_number = [&](const std::string& value) -> size_t {
+        if (value.empty() || value.size() > 9 || value.find_first_not_of("0123456789") != std::string::npos) {
+            std::cerr << "Expected a number, got " << value << '\n';
+            print_usage_and_exit(argv[0]);
+        }
+        return std::stoul(value);
+    };
+    // flags may go anywhere, the remaining arguments are positional
+    std::vector<std::string> positional;
+    // also try all 663'552 <R2, L2, U2, D2, F2, B2> states as prefixes and suffixes, ~10M checks per alg
+    bool half_turn_subgroup = false;
+    size_t half_turn_subgroup_step = 1;
+    const std::string step_flag = "--half-turn-subgroup-step=";
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--half-turn-subgroup") {
+            half_turn_subgroup = true;
+        } else if (arg.starts_with(step_flag)) {
+            half_turn_subgroup = true;
+            half_turn_subgroup_step = std::max<size_t>(parse_number(arg.substr(step_flag.size())), 1);
+        } else if (arg.starts_with("--")) {
+            std::cerr << "Unknown flag " << arg << '\n';
+            print_usage_and_exit(argv[0]);
+        } else {
+            positional.push_back(arg);
+        }
     }
-    const auto map = PatternToAlgMap::load_from_file(argv[1]);
+    const auto parse_count = [&](size_t i, size_t default_value) {
+        return i < positional.size() ? parse_number(positional[i]) : default_value;
+    };
+    if (positional.empty() || positional.size() > 3) {
+        print_usage_and_exit(argv[0]);
+    }
+    const auto& algs_path = positional[0];
+    const size_t num_threads = parse_count(1, std::max(1u, std::thread::hardware_concurrency()));
+    const size_t max_rounds = parse_count(2, 1);
+    const auto map = PatternToAlgMap::load_from_file(algs_path);
     if (map.empty()) {
-        std::cerr << "No algs found in " << argv[1] << '\n';
+        std::cerr << "No algs found in " << algs_path << '\n';
         return -1;
     }
-    auto augmented_map = map;
-    const auto path_to_augmented_algs = fmt::format("{}.augmented.txt", argv[1]);
-    auto save_augmented_algs = [&]() {
+    const auto path_to_augmented_algs = fmt::format("{}.augmented.txt", algs_path);
+    auto save_augmented_algs = [&](const PatternToAlgMap& augmented_map) {
         if (augmented_map.save_to_file(path_to_augmented_algs)) {
             std::cout << "Saved " << augmented_map.size() << " augmented algs to " << path_to_augmented_algs << '\n';
+            flush_trace();
         } else {
             std::cerr << "Failed to save augmented algs to " << path_to_augmented_algs << '\n';
             exit(-1);
         }
     };
-    save_augmented_algs(); // check that file is writable
-
-    // add in map if it's not there yet
-    const auto check_alg = [&](const std::string& alg) {
-        CubeState<sides333> cube;
-        cube.applyScramble(alg);
-        if (cube.doFrontAndBackSidesHaveSamePatternWithOppositeColors()) {
-            augmented_map.insert_if_shorter(cube.frontSideStickers(), alg);
-        }
-    };
-
-    const auto explore_alg = [&](const std::string& alg) {
-        check_alg(alg);
-        check_alg(invertScramble(alg));
-
-        check_alg(left2right(alg));
-        check_alg(left2right(invertScramble(alg)));
-
-        check_alg(front2back(alg));
-        check_alg(front2back(invertScramble(alg)));
-
-        check_alg(front2back(left2right(alg)));
-        check_alg(front2back(left2right(invertScramble(alg))));
-
-        check_alg(left2right(front2back(alg)));
-        check_alg(left2right(front2back(invertScramble(alg))));
-    };
+    save_augmented_algs(map); // check that file is writable
 
     const std::string meme = "R' L U D' F B' R' L";
     const std::string centers_shift = "R L' F2 B2 R L' U2 D2";
@@ -79,7 +101,7 @@ int main(int argc, char** argv) {
         left2right(invertScramble(meme)),
         front2back(invertScramble(meme)),
 
-        // Rotate the result (F2 B2 are already in the map). Then you may recursively explore the resulting map
+        // Rotate the result (F2 B2 are already in the map). Use max_rounds > 1 to explore the resulting algs as well
         "F B'", "F' B", "U D'", "U' D",
 
         // these do not preserve symmetry
@@ -145,59 +167,45 @@ int main(int argc, char** argv) {
         "L2 D2 L2 D2 L2 D2",
     };
 
-    uint64_t num_algs_checked = 0;
-    for (const auto& [pattern, alg] : map.get()) {
-        if (++num_algs_checked % 100 == 0) {
-            const auto all_algs_found_notice = (augmented_map.size() == 1679616) ? "ALL ALGS FOUND! " : "";
-            std::cout << all_algs_found_notice << "Checked " << num_algs_checked << "/" << map.size() << "; new algs added: "
-                      << (augmented_map.size() - map.size()) << std::endl;
-        }
-        if (alg.empty()) {
-            continue;
-        }
+    // side moves keep the green F center, so the target is 6^8 patterns, or the reachable ones with a green center if
+    // compute_reachable_patterns saved them next to the algs
+    size_t num_target_patterns = 1679616;
+    const auto reachable_path = (std::filesystem::path(algs_path).parent_path() / REACHABLE_PATTERNS_FILE_NAME).string();
+    if (std::filesystem::exists(reachable_path)) {
+        num_target_patterns = PatternBitmap::load_from_file(reachable_path).with_center('G').count();
+        std::cout << "Loaded " << num_target_patterns << " reachable patterns from " << reachable_path << std::endl;
+    }
 
-        for (const auto& addon : addon_algs) {
-            explore_alg(alg);
-
-            explore_alg(fmt::format("{} {}", alg, addon));
-            explore_alg(fmt::format("{} {}", addon, alg));
-            explore_alg(fmt::format("{} {} {}", addon, alg, addon));
-
-            // transform the alg independently
-            explore_alg(fmt::format("{} {}", alg, addon));
-            explore_alg(fmt::format("{} {}", invertScramble(alg), addon));
-            explore_alg(fmt::format("{} {}", left2right(alg), addon));
-            explore_alg(fmt::format("{} {}", left2right(invertScramble(alg)), addon));
-
-            explore_alg(fmt::format("{} {}", addon, alg));
-            explore_alg(fmt::format("{} {}", addon, invertScramble(alg)));
-            explore_alg(fmt::format("{} {}", addon, left2right(alg)));
-            explore_alg(fmt::format("{} {}", addon, left2right(invertScramble(alg))));
-
-            explore_alg(fmt::format("{} {} {}", addon, alg, addon));
-            explore_alg(fmt::format("{} {} {}", addon, invertScramble(alg), addon));
-            explore_alg(fmt::format("{} {} {}", addon, left2right(alg), addon));
-            explore_alg(fmt::format("{} {} {}", addon, left2right(invertScramble(alg)), addon));
-
-            // most random stuff
-            explore_alg(fmt::format("{} {}", alg, alg));
-            explore_alg(fmt::format("{} {}", alg, invertScramble(left2right(alg))));
-            explore_alg(fmt::format("{} {}", alg, invertScramble(front2back(alg))));
-
-            // misc
-            explore_alg(fmt::format("{} R2 L2 {}", addon, alg));
-            explore_alg(fmt::format("{} U2 D2 {}", addon, alg));
-            explore_alg(fmt::format("R2 L2 {} {}", addon, alg));
-            explore_alg(fmt::format("U2 D2 {} {}", addon, alg));
-            explore_alg(fmt::format("{} {} R2 L2", addon, alg));
-            explore_alg(fmt::format("{} {} U2 D2", addon, alg));
-            explore_alg(fmt::format("{} R2 L2 {} {}", addon, alg, addon));
-            explore_alg(fmt::format("{} U2 D2 {} {}", addon, alg, addon));
-        }
-        if (num_algs_checked % 1'000 == 0) {
-            save_augmented_algs();
+    const auto started_at = std::chrono::steady_clock::now();
+    size_t round = 1;
+    auto last_saved_at = started_at;
+    const auto on_progress = [&](const PatternToAlgMap& augmented_map, const AugmentationProgress& progress) {
+        const auto now = std::chrono::steady_clock::now();
+        const std::chrono::duration<double> elapsed = now - started_at;
+        const auto all_algs_found_notice = (augmented_map.size() >= num_target_patterns) ? "ALL ALGS FOUND! " : "";
+        std::cout << all_algs_found_notice << "Round " << round << ": checked " << progress.num_algs_checked << "/" << progress.num_algs_total
+                  << "; new algs added: " << (augmented_map.size() - map.size()) << "; "
+                  << fmt::format("{:.2f}M combinations/s", progress.num_combinations_checked / elapsed.count() / 1e6)
+                  << std::endl;
+        // saving happens on the merging thread, workers keep exploring meanwhile
+        if (progress.done || now - last_saved_at > std::chrono::minutes(1)) {
+            save_augmented_algs(augmented_map);
+            last_saved_at = now;
         }
-    }
-    save_augmented_algs();
+    };
+    const auto on_round_done = [&](const PatternToAlgMap& /*augmented_map*/, const AugmentationRound& report) {
+        std::cout << fmt::format("Round {} done: explored {} algs, {} new patterns (+{:.2f}%), {} improved algs, {} total",
+                                 report.round, report.num_algs_explored, report.num_new_patterns,
+                                 100. * report.num_new_patterns / (report.map_size - report.num_new_patterns),
+                                 report.num_improved_algs, report.map_size) << std::endl << counters_report();
+        ++round;
+    };
+    std::cout << "Exploring " << map.size() << " algs on " << num_threads << " threads, up to " << max_rounds
+              << " rounds" << (half_turn_subgroup ? ", with half turn subgroup addons" : "")
+              << (half_turn_subgroup_step > 1 ? fmt::format(" (1 in {} states)", half_turn_subgroup_step) : "")
+              << std::endl;
+    augment_until_fixpoint(map, MosaicAugmenter(addon_algs, half_turn_subgroup, half_turn_subgroup_step),
+                           {.num_threads = num_threads, .stop_at_map_size = num_target_patterns}, max_rounds,
+                           on_progress, on_round_done);
     return 0;
 }
@@ -0,0 +1,84 @@
+#include "gtest/gtest.h"
+#include "cubing/CompressedAlgFile.h"
+#include "cubing/MosaicDefs.h"
+#include <filesystem>
+#include <random>
+#include <unordered_map>
+#include <string>
+
+using namespace cubing;
+
+static std::string temp_path(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+static std::unordered_map<std::string, std::string> make_random_map(size_t size) {
+    std::mt19937 rng(42);
+    const std::vector<std::string> moves = {"R", "U'", "F2", "Rw'", "x", "M2", "S'", "Bw2", "y'", "z2", "E"};
+    std::unordered_map<std::string, std::string> result;
+    while (result.size() < size) {
+        std::string alg;
+        const size_t num_moves = rng() % 15;
+        for (size_t i = 0; i < num_moves; ++i) {
+            alg += (i > 0 ? " " : "") + moves[rng() % moves.size()];
+        }
+        result[index_to_pattern(rng() % 10'077'696)] = alg;
+    }
+    return result;
+}
+
+TEST(CompressedAlgFile, PatternIndex) {
+    ASSERT_EQ(pattern_to_index("WWWWWWWWW"), 0);
+    ASSERT_EQ(pattern_to_index("WWWWWWWWG"), 1);
+    ASSERT_EQ(index_to_pattern(pattern_to_index("GROYBWGRB")), "GROYBWGRB");
+    ASSERT_THROW(pattern_to_index("GGGGGGGG"), std::runtime_error);
+    ASSERT_THROW(pattern_to_index("GGGGGGGGX"), std::runtime_error);
+}
+
+TEST(CompressedAlgFile, RoundTrip) {
+    auto map = make_random_map(10'000);
+    map["GGGGGGGGG"] = ""; // empty alg is valid
+    map["WGWGWGWGW"] = "R  U"; // doesn't tokenize, stored raw
+    map["BBBBBBBBB"] = "3Rw x'";
+    const auto path = temp_path("compressed_alg_file_round_trip.algz");
+    ASSERT_TRUE(save_compressed_alg_file(path, map, 100));
+    ASSERT_TRUE(is_compressed_alg_file(path));
+    ASSERT_EQ(load_compressed_alg_file(path), map);
+
+    // also through PatternToAlgMap, which picks the format by extension / signature
+    const auto text_path = temp_path("compressed_alg_file_round_trip.txt");
+    ASSERT_TRUE(PatternToAlgMap::load_from_file(path).save_to_file(text_path));
+    ASSERT_FALSE(is_compressed_alg_file(text_path));
+    ASSERT_EQ(PatternToAlgMap::load_from_file(text_path).get(), map);
+    ASSERT_LT(std::filesystem::file_size(path), std::filesystem::file_size(text_path) / 2);
+    std::filesystem::remove(path);
+    std::filesystem::remove(text_path);
+}
+
+TEST(CompressedAlgFile, Seek) {
+    const auto map = make_random_map(5'000);
+    const auto path = temp_path("compressed_alg_file_seek.algz");
+    ASSERT_TRUE(save_compressed_alg_file(path, map, 64));
+    CompressedAlgFileReader reader(path);
+    ASSERT_EQ(reader.size(), map.size());
+    ASSERT_EQ(reader.num_blocks(), (map.size() + 63) / 64);
+    for (const auto& [pattern, alg] : map) {
+        const auto found = reader.find(pattern);
+        ASSERT_TRUE(found.has_value()) << pattern;
+        ASSERT_EQ(*found, alg);
+    }
+    for (const std::string pattern : {"WWWWWWWWW", "BBBBBBBBB", "ROYGBWROY"}) {
+        if (!map.count(pattern)) {
+            ASSERT_FALSE(reader.find(pattern).has_value()) << pattern;
+        }
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(CompressedAlgFile, Empty) {
+    const auto path = temp_path("compressed_alg_file_empty.algz");
+    ASSERT_TRUE(save_compressed_alg_file(path, {}));
+    ASSERT_TRUE(load_compressed_alg_file(path).empty());
+    ASSERT_FALSE(CompressedAlgFileReader(path).find("GGGGGGGGG").has_value());
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,52 @@
+#include "gtest/gtest.h"
+#include "cubing/ConvenienceScore.h"
+#include "cubing/IterativeScramble.h"
+#include "cubing/ScrambleProcessing.h"
+#include "cubing/MosaicDefs.h"
+
+using namespace cubing;
+
+template<QtmMoveSetSize qtmMoveSetSize>
+static std::string combined_moves(const MovesVector<qtmMoveSetSize>& moves) {
+    return qtmMoveSetSize == sidesAndMid333 ? moves.to_string_combined_moves() : moves.to_string();
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+static void check_scores_match_strings(size_t max_size) {
+    const auto& scorer = ConvenienceScorer<qtmMoveSetSize>::instance();
+    for (IterativeScramble<qtmMoveSetSize> scramble; scramble.get().size() <= max_size; ++scramble) {
+        const auto& moves = scramble.get();
+        const auto score = scorer.score(moves);
+        ASSERT_EQ(score, execution_convenience_score(combined_moves(moves))) << moves.to_string();
+
+        typename ConvenienceScorer<qtmMoveSetSize>::PrefixScore prefix;
+        for (const auto move : moves) {
+            ASSERT_LE(scorer.lower_bound(prefix), score) << moves.to_string();
+            prefix = scorer.append(prefix, move);
+        }
+        ASSERT_LE(scorer.lower_bound(prefix), score) << moves.to_string();
+        ASSERT_EQ(scorer.finish(prefix), score) << moves.to_string();
+    }
+}
+
+TEST(ConvenienceScore, MatchesStringScores) {
+    check_scores_match_strings<sides333>(3);
+    check_scores_match_strings<sidesAndMid333>(3);
+}
+
+TEST(ConvenienceScore, MatchesStringScoresOnLongAlgs) {
+    const auto& scorer = ConvenienceScorer<sidesAndMid333>::instance();
+    for (const auto& alg : {"R L' U D' F B' R L' U D' F B'", "M' U M U2 M' U M", "R M' L' U E' D' F S B'",
+                            "R M' L' R' M L U2 E2 D2 R2 M2 L2 S F' B"}) {
+        const auto moves = MovesVector<sidesAndMid333>::from_string(alg);
+        ASSERT_EQ(scorer.score(moves), execution_convenience_score(moves.to_string_combined_moves())) << alg;
+    }
+}
+
+TEST(ConvenienceScore, InsertMovesIfMoreConvenient) {
+    PatternToAlgAndConvenienceMap map;
+    ASSERT_TRUE(map.insert_if_more_convenient("p", MovesVector<sidesAndMid333>::from_string("R M' L'")));
+    ASSERT_EQ(map.get().at("p").alg, "x");
+    ASSERT_EQ(map.get().at("p").convenience_score, execution_convenience_score("x"));
+    ASSERT_FALSE(map.insert_if_more_convenient("p", MovesVector<sidesAndMid333>::from_string("R M' L'")));
+}
@@ -0,0 +1,44 @@
+#include "gtest/gtest.h"
+#include "cubing/Counters.h"
+#include "cubing/CubeState.h"
+#include "cubing/IterativeScramble.h"
+#include <thread>
+
+using namespace cubing;
+
+static uint64_t counter_value(const CountersSnapshot& snapshot, HotPathCounter counter) {
+    return snapshot[size_t(counter)];
+}
+
+TEST(Counters, CountMovesAndParsesAcrossThreads) {
+    const auto before = counters_snapshot();
+    std::thread([] {
+        CubeState<sidesAndMid333> cube;
+        cube.applyScramble("R U M'");
+    }).join();
+    CubeState<sides333> cube;
+    cube.applyScramble("R U");
+    const auto after = counters_snapshot();
+
+    const uint64_t expected_moves = counters_enabled() ? 5 : 0;
+    ASSERT_EQ(counter_value(after, HotPathCounter::movesApplied) - counter_value(before, HotPathCounter::movesApplied),
+              expected_moves);
+    ASSERT_EQ(counter_value(after, HotPathCounter::scrambleParsedMoves)
+              - counter_value(before, HotPathCounter::scrambleParsedMoves), expected_moves);
+    ASSERT_EQ(counter_value(after, HotPathCounter::scrambleParses) - counter_value(before, HotPathCounter::scrambleParses),
+              counters_enabled() ? 2 : 0);
+    ASSERT_EQ(counters_report().empty(), !counters_enabled());
+}
+
+TEST(Counters, CountCanonicalRejections) {
+    const auto before = counters_snapshot();
+    IterativeScramble<sides333> scramble;
+    while (scramble.size() < 3) {
+        ++scramble;
+    }
+    const auto after = counters_snapshot();
+    const auto rejections = counter_value(after, HotPathCounter::canonicalRejections)
+                            - counter_value(before, HotPathCounter::canonicalRejections);
+    ASSERT_EQ(rejections > 0, counters_enabled());
+    ASSERT_EQ(counter_name(HotPathCounter::canonicalRejections), "canonical_rejections");
+}
@@ -1,6 +1,7 @@
 #include "gtest/gtest.h"
 #include "cubing/CubeState.h"
 #include "cubing/CubingDefs.h"
+#include "cubing/ScrambleProcessing.h"
 
 using namespace cubing;
 TEST(Cube, Basic) {
@@ -85,3 +86,46 @@ TEST(Cube, SideColors) {
     ASSERT_EQ(cube.topSideStickers(true), "WWWWWWWWW");
     ASSERT_EQ(cube.frontSideStickers(true), "GGGGGGGGG");
 }
+
+template<QtmMoveSetSize moveSetSize>
+void permutationTests(const std::string& alg1, const std::string& alg2) {
+    const auto p1 = CubeState<moveSetSize>::compileAlgorithm(alg1);
+    const auto p2 = CubeState<moveSetSize>::compileAlgorithm(alg2);
+
+    // applying compiled alg == applying its moves
+    CubeState<moveSetSize> byMoves, byPermutation;
+    byMoves.applyScramble(alg1 + " " + alg2);
+    byPermutation.applyPermutation(p1);
+    byPermutation.applyPermutation(p2);
+    ASSERT_EQ(byMoves, byPermutation) << alg1 << " " << alg2;
+
+    // composition
+    auto composed = p1;
+    composed.applyPermutation(p2);
+    ASSERT_EQ(composed, CubeState<moveSetSize>::compileAlgorithm(alg1 + " " + alg2));
+
+    // inversion
+    ASSERT_EQ(p1.inversePermutation(), CubeState<moveSetSize>::compileAlgorithm(invertScramble(alg1)));
+    auto identity = p1;
+    identity.applyPermutation(p1.inversePermutation());
+    ASSERT_EQ(identity, CubeState<moveSetSize>::identityPermutation());
+    byPermutation.applyPermutation(composed.inversePermutation());
+    ASSERT_TRUE(byPermutation.isSolved());
+
+    // inverse state straight from the permutation
+    CubeState<moveSetSize> byInverseMoves, byInversePermutation;
+    byInverseMoves.applyScramble(invertScramble(alg1));
+    byInversePermutation.applyInversePermutation(p1);
+    ASSERT_EQ(byInverseMoves, byInversePermutation) << alg1;
+    auto inverted = composed;
+    inverted.applyInversePermutation(p2);
+    ASSERT_EQ(inverted, p1);
+}
+
+TEST(Cube, Permutations) {
+    permutationTests<sides333>("R U R' U'", "F2 B' L D2");
+    permutationTests<sides333>("R", "R");
+    permutationTests<sidesAndMid333>("R M' U E2 S", "F S' B2 L'");
+    permutationTests<allMoves555>("r U' M f2", "b' E d R2");
+    ASSERT_EQ(CubeState<sides333>::compileAlgorithm(""), CubeState<sides333>::identityPermutation());
+}
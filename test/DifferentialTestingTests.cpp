@@ -0,0 +1,56 @@
+#include "gtest/gtest.h"
+#include "cubing/DifferentialTesting.h"
+
+using namespace cubing;
+
+template<QtmMoveSetSize qtmMoveSetSize>
+static void check_builtin_engines_match() {
+    const DifferentialTester<qtmMoveSetSize> tester(DifferentialTester<qtmMoveSetSize>::builtin_engines());
+    const auto reports = tester.run({.num_sequences = 200, .max_moves = 30, .seed = 7});
+    ASSERT_EQ(reports.size(), 4);
+    for (const auto& report : reports) {
+        ASSERT_EQ(report.num_mismatches, 0) << qtmMoveSetSize << " " << report.name << ": <" << report.counterexample
+                                            << "> " << report.mismatch;
+        ASSERT_GT(report.moves_per_second, 0);
+        ASSERT_EQ(report.num_mosaics, reports.front().num_mosaics) << report.name;
+    }
+    ASSERT_GT(reports.front().num_mosaics, 0); // e.g. short sequences that keep F and B untouched
+}
+
+TEST(DifferentialTesting, BuiltinEnginesMatchReference) {
+    check_builtin_engines_match<sides333>();
+    check_builtin_engines_match<sidesAndMid333>();
+    check_builtin_engines_match<allMoves555>();
+}
+
+TEST(DifferentialTesting, MinimizesCounterexample) {
+    using Tester = DifferentialTester<sidesAndMid333>;
+    auto engines = Tester::builtin_engines();
+    engines.resize(1);
+    // broken engine: treats M2 as M
+    const uint8_t m2 = MovesVector<sidesAndMid333>::from_string("M2").front();
+    const uint8_t m = MovesVector<sidesAndMid333>::from_string("M").front();
+    engines.push_back({"broken", [reference = engines.front(), m2, m](const MovesVector<sidesAndMid333>& moves) {
+        auto broken = moves;
+        for (auto& move : broken) {
+            move = move == m2 ? m : move;
+        }
+        return reference.scramble(broken);
+    }});
+    const auto reports = Tester(engines).run({.num_sequences = 300, .max_moves = 40, .seed = 3});
+    ASSERT_EQ(reports[0].num_mismatches, 0);
+    ASSERT_GT(reports[1].num_mismatches, 0);
+    ASSERT_EQ(reports[1].counterexample, "M2");
+    ASSERT_NE(reports[1].mismatch.find("orbits differ"), std::string::npos) << reports[1].mismatch;
+}
+
+TEST(DifferentialTesting, MinimizeIsOneMinimal) {
+    using Moves = MovesVector<sides333>;
+    const auto moves = Moves::from_string("R U F L D B R2 U2 F2 L2 D2 B2");
+    // fails if both U and L2 are there
+    const auto fails = [](const Moves& m) {
+        const auto s = " " + m.to_string() + " ";
+        return s.find(" U ") != std::string::npos && s.find(" L2 ") != std::string::npos;
+    };
+    ASSERT_EQ(DifferentialTester<sides333>::minimize(moves, fails).to_string(), "U L2");
+}
@@ -0,0 +1,81 @@
+#include "gtest/gtest.h"
+#include "cubing/FacePatternPredicate.h"
+#include "cubing/RandomScramble.h"
+#include "cubing/ScrambleProcessing.h"
+
+using namespace cubing;
+
+TEST(FacePatternPredicate, TwoSidedMosaicSpecMatchesCubeState) {
+    const auto predicate = FacePatternPredicate<sidesAndMid333>::compile(TWO_SIDED_MOSAIC_PREDICATE);
+    ASSERT_EQ(predicate.num_key_stickers(), 9);
+    ASSERT_EQ(predicate.num_checks(), 9);
+    RandomScramble<sidesAndMid333> random(46);
+    size_t num_matches = 0;
+    for (size_t length : {0, 1, 2, 5, 8}) {
+        for (const auto& cube : random.generate_states(length, 2000)) {
+            const bool expected = cube.doFrontAndBackSidesHaveSamePatternWithOppositeColors();
+            ASSERT_EQ(predicate.matches(cube), expected) << cube.toString();
+            ASSERT_EQ(predicate.key(cube), cube.frontSideStickers());
+            num_matches += expected;
+        }
+    }
+    ASSERT_GT(num_matches, 0);
+    CubeState<sidesAndMid333> cube;
+    cube.applyScramble("M2 E2 S2"); // superflip-like pattern with swapped opposite centers
+    ASSERT_EQ(predicate.matches(cube), cube.doFrontAndBackSidesHaveSamePatternWithOppositeColors());
+}
+
+TEST(FacePatternPredicate, OppositeFacesCorrespondThroughTheCube) {
+    // rotating the cube with x moves F to U, so U and D of a conjugated alg show the F and B pattern of the alg
+    const auto front_back = FacePatternPredicate<sidesAndMid333>::compile("opposite F B");
+    const auto up_down = FacePatternPredicate<sidesAndMid333>::compile("opposite U D");
+    const auto x = MovesVector<sidesAndMid333>::from_string(scrambleTearApart333("x"));
+    const auto x_prime = MovesVector<sidesAndMid333>::from_string(scrambleTearApart333("x'"));
+    RandomScramble<sidesAndMid333> random(47);
+    for (size_t i = 0; i < 5000; ++i) {
+        const auto moves = random.next(1 + i % 6);
+        CubeState<sidesAndMid333> cube, rotated;
+        cube.applyScramble(moves);
+        rotated.applyScramble(x_prime);
+        rotated.applyScramble(moves);
+        rotated.applyScramble(x);
+        ASSERT_EQ(up_down.matches(rotated), front_back.matches(cube)) << moves.to_string();
+    }
+}
+
+TEST(FacePatternPredicate, FixedAndEqualRules) {
+    const auto predicate = FacePatternPredicate<sides333>::compile(R"(
+        # white cross on U, same colors on L and R around the centers
+        key F8
+        fixed U ?W?WWW?W?
+        equal L8 R8
+    )");
+    ASSERT_EQ(predicate.num_key_stickers(), 8);
+    ASSERT_EQ(predicate.num_checks(), 5 + 8);
+    CubeState<sides333> cube;
+    ASSERT_FALSE(predicate.matches(cube)); // L and R have different colors when solved
+    cube.applyScramble("R2 L2");
+    ASSERT_FALSE(predicate.matches(cube));
+    const auto fixed_only = FacePatternPredicate<sides333>::compile("fixed U ?W?WWW?W?");
+    ASSERT_TRUE(fixed_only.matches(CubeState<sides333>{}));
+    ASSERT_EQ(fixed_only.key(CubeState<sides333>{}), "WWWWWWWWW");
+    cube = CubeState<sides333>();
+    cube.applyScramble("D2 R U R' U R U2 R'"); // sune keeps the white cross
+    ASSERT_TRUE(fixed_only.matches(cube));
+    cube.applyScramble("U F");
+    ASSERT_FALSE(fixed_only.matches(cube));
+    ASSERT_EQ(predicate.key(CubeState<sides333>{}), "GGGGGGGG");
+}
+
+TEST(FacePatternPredicate, InvalidSpecsThrow) {
+    for (const std::string spec : {"", "# only a comment", "key X", "key F9", "equal F", "opposite F8 B",
+                                   "fixed U WWW", "fixed U WWWWWWWWK", "same F B"}) {
+        ASSERT_THROW(FacePatternPredicate<sides333>::compile(spec), std::runtime_error) << spec;
+    }
+    try {
+        FacePatternPredicate<sides333>::compile("key F\n\nequal F Q");
+        FAIL();
+    } catch (const std::runtime_error& e) {
+        ASSERT_NE(std::string(e.what()).find("line 3"), std::string::npos) << e.what();
+    }
+}
@@ -0,0 +1,84 @@
+#include "gtest/gtest.h"
+#include "cubing/FinderTelemetry.h"
+#include <filesystem>
+
+using namespace cubing;
+using namespace std::chrono_literals;
+
+TEST(FinderTelemetry, RatesAndProjection) {
+    const FinderTelemetry::Clock::time_point start{};
+    FinderTelemetry telemetry(start);
+    for (int i = 0; i < 1000; ++i) {
+        telemetry.on_candidate(4);
+    }
+    telemetry.on_hit(true);
+    telemetry.on_hit(false);
+    telemetry.update(4, 0.25, 10, 100, start + 2s);
+
+    ASSERT_EQ(telemetry.depths().size(), 1);
+    ASSERT_EQ(telemetry.depths().back().candidates, 1000);
+    ASSERT_DOUBLE_EQ(telemetry.projected_seconds_left_in_depth(), 6.);
+
+    const auto json = telemetry.to_json();
+    ASSERT_NE(json.find(R"("candidates_per_second": 500.0)"), std::string::npos) << json;
+    ASSERT_NE(json.find(R"("moves_applied_per_second": 2000.0)"), std::string::npos) << json;
+    ASSERT_NE(json.find(R"("improvement_rate": 0.500000)"), std::string::npos) << json;
+    ASSERT_NE(json.find(R"("projected_seconds_left": 6.0)"), std::string::npos) << json;
+}
+
+TEST(FinderTelemetry, CountsRotatedAndInverseHitsSeparately) {
+    const FinderTelemetry::Clock::time_point start{};
+    FinderTelemetry telemetry(start);
+    using HitSource = FinderTelemetry::HitSource;
+    for (int i = 0; i < 10; ++i) {
+        telemetry.on_candidate(4);
+    }
+    // one candidate with a hit on every face pair and its inverse matching too
+    telemetry.on_hit(true);
+    telemetry.on_hit(true, HitSource::rotated);
+    telemetry.on_hit(false, HitSource::rotated);
+    telemetry.on_hit(true, HitSource::inverse);
+    telemetry.update(4, 0.5, 3, 100, start + 1s);
+
+    const auto json = telemetry.to_json();
+    ASSERT_NE(json.find(R"("hits": 1,)"), std::string::npos) << json;
+    ASSERT_NE(json.find(R"("hit_rate": 0.100000000)"), std::string::npos) << json;
+    ASSERT_NE(json.find(R"("improvement_rate": 1.000000)"), std::string::npos) << json;
+    ASSERT_NE(json.find(R"("rotated_hits": 2,)"), std::string::npos) << json;
+    ASSERT_NE(json.find(R"("rotated_improvements": 1,)"), std::string::npos) << json;
+    ASSERT_NE(json.find(R"("inverse_hits": 1,)"), std::string::npos) << json;
+    ASSERT_NE(json.find(R"("inverse_improvements": 1,)"), std::string::npos) << json;
+}
+
+TEST(FinderTelemetry, ClosesDepthWhenItChanges) {
+    const FinderTelemetry::Clock::time_point start{};
+    FinderTelemetry telemetry(start);
+    telemetry.on_candidate(4);
+    telemetry.update(4, 0.5, 0, 100, start + 1s);
+    telemetry.on_candidate(4);
+    telemetry.update(5, 0., 0, 100, start + 3s);
+    telemetry.on_candidate(5);
+    telemetry.update(5, 0.1, 0, 100, start + 4s);
+
+    const auto& depths = telemetry.depths();
+    ASSERT_EQ(depths.size(), 2);
+    ASSERT_TRUE(depths[0].completed);
+    ASSERT_EQ(depths[0].candidates, 2);
+    ASSERT_DOUBLE_EQ(depths[0].seconds, 3.);
+    ASSERT_FALSE(depths[1].completed);
+    ASSERT_EQ(depths[1].candidates, 1);
+    ASSERT_DOUBLE_EQ(depths[1].seconds, 1.);
+}
+
+TEST(FinderTelemetry, UnknownProjectionIsNull) {
+    FinderTelemetry telemetry;
+    telemetry.update(1, 0., 0, 100);
+    ASSERT_LT(telemetry.projected_seconds_left_in_depth(), 0);
+    ASSERT_NE(telemetry.to_json().find(R"("projected_seconds_left": null)"), std::string::npos);
+
+    const auto path = (std::filesystem::temp_directory_path() / "finder_telemetry_test.json").string();
+    ASSERT_TRUE(telemetry.save_to_file(path));
+    ASSERT_TRUE(std::filesystem::exists(path));
+    ASSERT_FALSE(std::filesystem::exists(path + ".tmp"));
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,60 @@
+#include "gtest/gtest.h"
+#include "cubing/HalfTurnSubgroup.h"
+#include "cubing/MosaicAugmentation.h"
+#include <set>
+
+using namespace cubing;
+
+TEST(HalfTurnSubgroup, StatesWithShortestSequences) {
+    const auto& subgroup = HalfTurnSubgroup::instance();
+    ASSERT_EQ(subgroup.size(), HalfTurnSubgroup::NUM_STATES);
+    ASSERT_EQ(subgroup.permutation(0), CubeState<sides333>::identityPermutation());
+    ASSERT_TRUE(subgroup.moves(0).empty());
+    std::vector<size_t> num_states_by_length;
+    for (size_t i = 0; i < subgroup.size(); ++i) {
+        if (i > 0) {
+            ASSERT_GE(subgroup.length(i), subgroup.length(i - 1));
+        }
+        num_states_by_length.resize(subgroup.length(i) + 1);
+        ++num_states_by_length[subgroup.length(i)];
+        if (i % 997 == 0) {
+            const auto moves = subgroup.moves(i);
+            ASSERT_EQ(moves.size(), subgroup.length(i));
+            ASSERT_EQ(moves.canonicalized().to_string(), moves.to_string());
+            ASSERT_EQ(CubeState<sides333>::compileAlgorithm(moves), subgroup.permutation(i)) << moves.to_string();
+        }
+    }
+    ASSERT_EQ(num_states_by_length[1], 6);
+    ASSERT_EQ(num_states_by_length[2], 27); // 36 pairs, minus 6 cancelling and 3 commuting duplicates
+    ASSERT_LE(num_states_by_length.size(), 16);
+}
+
+TEST(HalfTurnSubgroup, AugmenterFindsAllSubgroupMosaics) {
+    // a sampled slice of the subgroup keeps the test fast, all of it is ~10M checks
+    constexpr size_t step = 97;
+    const auto& subgroup = HalfTurnSubgroup::instance();
+    std::set<std::string> expected;
+    for (size_t i = 0; i < subgroup.size(); i += step) {
+        CubeState<sides333> cube;
+        cube.applyPermutation(subgroup.permutation(i));
+        if (cube.doFrontAndBackSidesHaveSamePatternWithOppositeColors()) {
+            expected.insert(cube.frontSideStickers());
+        }
+    }
+    ASSERT_GT(expected.size(), 1);
+
+    // the empty alg combined with every state as a suffix is every state
+    PatternToAlgMap map;
+    map.insert("GGGGGGGGG", "");
+    MosaicAugmenter augmenter({}, true, step);
+    augmenter.explore("", map);
+    ASSERT_EQ(augmenter.num_combinations_checked(), NUM_SYMMETRY_VARIANTS * 2 * ((subgroup.size() + step - 1) / step));
+    std::set<std::string> found;
+    for (const auto& [pattern, alg] : map.get()) {
+        CubeState<sides333> cube;
+        cube.applyScramble(alg);
+        ASSERT_EQ(cube.frontSideStickers(), pattern) << alg;
+        found.insert(pattern);
+    }
+    ASSERT_EQ(found, expected);
+}
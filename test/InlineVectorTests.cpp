@@ -0,0 +1,51 @@
+#include "gtest/gtest.h"
+#include "cubing/InlineVector.h"
+#include "cubing/MovesVector.h"
+#include <numeric>
+
+using namespace cubing;
+
+TEST(InlineVector, StaysInlineUpToCapacity) {
+    InlineVector<uint8_t, 4> v;
+    for (uint8_t i = 0; i < 4; ++i) {
+        v.push_back(i);
+    }
+    ASSERT_TRUE(v.is_inline());
+    const auto copy = v;
+    ASSERT_TRUE(copy.is_inline());
+    ASSERT_EQ(copy, v);
+    ASSERT_EQ(copy.back(), 3);
+}
+
+TEST(InlineVector, SpillsToHeap) {
+    InlineVector<uint8_t, 4> v;
+    for (uint8_t i = 0; i < 100; ++i) {
+        v.push_back(i);
+    }
+    ASSERT_FALSE(v.is_inline());
+    ASSERT_EQ(v.size(), 100);
+    ASSERT_EQ(std::accumulate(v.begin(), v.end(), 0), 99 * 100 / 2);
+
+    auto copy = v;
+    ASSERT_EQ(copy, v);
+    copy[0] = 42;
+    ASSERT_EQ(v[0], 0);
+
+    auto moved = std::move(copy);
+    ASSERT_EQ(moved[0], 42);
+    ASSERT_EQ(moved.size(), 100);
+    ASSERT_TRUE(copy.empty());
+
+    moved.resize(2);
+    copy = moved; // small enough to be copied inline
+    ASSERT_TRUE(copy.is_inline());
+    ASSERT_EQ(copy, moved);
+    ASSERT_EQ(*copy.rbegin(), 1);
+}
+
+TEST(InlineVector, MovesVectorIsInline) {
+    static_assert(sizeof(MovesVector<sides333>) == 64);
+    const auto moves = MovesVector<sides333>::from_string("R U R' U' R' F R2 U' R' U' R U R' F'");
+    const auto copy = moves;
+    ASSERT_EQ(copy.to_string(), moves.to_string());
+}
@@ -150,3 +150,22 @@ TEST(IterativeScramble, NoParallelMovesDuringIteration) {
 //        ASSERT_FALSE(alg_str.find("L' L") != std::string::npos);
     }
 }
+
+TEST(IterativeScramble, ProgressFractionGrowsWithinSize) {
+    IterativeScramble<sides333> scramble;
+    while (scramble.size() < 2) {
+        ++scramble;
+    }
+    double previous = scramble.progress_fraction();
+    ASSERT_LT(previous, 0.1);
+    while (scramble.size() == 2) {
+        ++scramble;
+        const double fraction = scramble.progress_fraction();
+        if (scramble.size() == 2) {
+            ASSERT_GT(fraction, previous) << scramble.get().to_string();
+            ASSERT_LT(fraction, 1.0);
+        }
+        previous = fraction;
+    }
+    ASSERT_LT(scramble.progress_fraction(), 0.1); // restarted at size 3
+}
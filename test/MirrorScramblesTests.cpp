@@ -0,0 +1,37 @@
+#include "gtest/gtest.h"
+#include "cubing/MirrorScrambles.h"
+#include <vector>
+#include <string>
+
+using namespace cubing;
+
+TEST(MirrorScrambles, MirrorMoves) {
+    const std::vector<std::pair<std::string, std::string>> lr = {
+        {"R", "L'"}, {"L'", "R"}, {"R2", "L2"}, {"3Rw'", "3Lw"}, {"Lw2", "Rw2"}, {"r", "l'"}, {"l2", "r2"},
+        {"3r", "3r"}, {"U", "U'"}, {"Fw'", "Fw"}, {"2B2", "2B2"}, {"x", "x"}, {"M'", "M'"}, {"Mw", "Mw'"},
+        {"y", "y'"}, {"S'", "S"}, {"R2'", "R2'"}, {"?", "?"}, {"", ""},
+    };
+    for (const auto& [move, mirrored] : lr) {
+        ASSERT_EQ(mirrorUfmMoveLr(move), mirrored) << move;
+    }
+    const std::vector<std::pair<std::string, std::string>> ud = {
+        {"U", "D'"}, {"4Dw", "4Uw'"}, {"u'", "d"}, {"y'", "y'"}, {"E", "E"}, {"e2", "e2"}, {"R", "R'"}, {"x", "x'"},
+    };
+    for (const auto& [move, mirrored] : ud) {
+        ASSERT_EQ(mirrorUfmMoveUd(move), mirrored) << move;
+    }
+    const std::vector<std::pair<std::string, std::string>> fb = {
+        {"F", "B'"}, {"Bw2", "Fw2"}, {"f", "b'"}, {"z", "z"}, {"S'", "S'"}, {"s", "s"}, {"M", "M'"}, {"D2", "D2"},
+    };
+    for (const auto& [move, mirrored] : fb) {
+        ASSERT_EQ(mirrorUfmMoveFb(move), mirrored) << move;
+    }
+}
+
+TEST(MirrorScrambles, MirrorAlgs) {
+    ASSERT_EQ(mirrorUfmAlg("R U R' U'", mirrorLr), "L' U' L U");
+    ASSERT_EQ(mirrorUfmAlg("Rw U2 x M'  r", mirrorLr), "Lw' U2 x M'  l'");
+    ASSERT_EQ(mirrorUfmAlg("", mirrorUd), "");
+    const std::vector<std::string_view> algs = {"F R", "3Fw' S"};
+    ASSERT_EQ(mirrorUfmAlgs(algs, mirrorFb), (std::vector<std::string>{"B' R'", "3Bw S"}));
+}
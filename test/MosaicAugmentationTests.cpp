@@ -0,0 +1,138 @@
+#include "gtest/gtest.h"
+#include "cubing/MosaicAugmentation.h"
+#include "cubing/ScrambleProcessing.h"
+#include "cubing/CubeState.h"
+#include <vector>
+#include <string>
+
+using namespace cubing;
+
+TEST(MosaicAugmentation, SymmetryVariants) {
+    const std::string alg = "R U2 F' D L2 B";
+    ASSERT_EQ(apply_symmetry_variant(alg, 0), alg);
+    ASSERT_EQ(apply_symmetry_variant(alg, variantInverse), invertScramble(alg));
+    ASSERT_EQ(apply_symmetry_variant(alg, variantLeft2Right | variantFront2Back), front2back(left2right(alg)));
+    ASSERT_EQ(apply_symmetry_variant(alg, variantLeft2Right | variantFront2Back), left2right(front2back(alg)));
+
+    const auto compiled = CompiledAlgVariants::compile(alg);
+    for (uint8_t variant = 0; variant < NUM_SYMMETRY_VARIANTS; ++variant) {
+        ASSERT_EQ(compiled.permutations[variant], CubeState<sides333>::compileAlgorithm(compiled.algs[variant]));
+    }
+}
+
+TEST(MosaicAugmentation, ExploreFindsValidAlgs) {
+    PatternToAlgMap map;
+    map.insert("GGGGGGGGG", "");
+    MosaicAugmenter augmenter({"R2 L2", "U2 D2 F2 B2", "R' L U D' F B' R' L"});
+    augmenter.explore("F2 B2", map);
+    ASSERT_GT(map.size(), 1);
+    ASSERT_GT(augmenter.num_combinations_checked(), 0);
+    for (const auto& [pattern, alg] : map.get()) {
+        CubeState<sides333> cube;
+        cube.applyScramble(alg);
+        ASSERT_TRUE(cube.doFrontAndBackSidesHaveSamePatternWithOppositeColors()) << alg;
+        ASSERT_EQ(cube.frontSideStickers(), pattern) << alg;
+    }
+}
+
+TEST(MosaicAugmentation, InsertIfPreferred) {
+    PatternToAlgMap map;
+    ASSERT_TRUE(map.insert_if_shorter("GGGGGGGGG", "R2 L2 R2 L2"));
+    ASSERT_TRUE(map.insert_if_shorter("GGGGGGGGG", "U2 D2"));
+    ASSERT_EQ(map.get().at("GGGGGGGGG"), "U2 D2");
+    ASSERT_FALSE(map.insert_if_shorter("GGGGGGGGG", "R2 L2"));
+    ASSERT_TRUE(map.insert_if_preferred("GGGGGGGGG", "R2 L2"));
+    ASSERT_EQ(map.get().at("GGGGGGGGG"), "R2 L2");
+    ASSERT_FALSE(map.insert_if_preferred("GGGGGGGGG", "U2 D2"));
+
+    PatternToAlgMap other;
+    other.insert("GGGGGGGGG", "F2 B2");
+    other.insert("BBBBBBBBB", "x2");
+    ASSERT_EQ(map.merge(other), 2);
+    ASSERT_EQ(map.get().at("GGGGGGGGG"), "F2 B2");
+}
+
+TEST(MosaicAugmentation, ParallelIsDeterministic) {
+    PatternToAlgMap map;
+    map.insert("GGGGGGGGG", "");
+    const std::vector<std::string> algs = {"F2 B2", "R L' F2 B2 R L' U2 D2", "R2 L2 U2 D2", "U D' F' B' D'"};
+    for (const auto& alg : algs) {
+        CubeState<sides333> cube;
+        cube.applyScramble(alg);
+        map.insert(cube.frontSideStickers(), alg);
+    }
+    const MosaicAugmenter augmenter({"R2 L2", "F B'", "U2 D2 F2 B2"});
+    const auto single_thread = augment_in_parallel(map, algs, augmenter, {.num_threads = 1}, [](auto&&...) {});
+    size_t num_progress_calls = 0;
+    const auto multi_thread = augment_in_parallel(map, algs, augmenter, {.num_threads = 4, .algs_per_batch = 1},
+        [&](const PatternToAlgMap&, const AugmentationProgress& progress) {
+            ++num_progress_calls;
+            ASSERT_LE(progress.num_algs_checked, algs.size());
+        });
+    ASSERT_GT(single_thread.size(), map.size());
+    ASSERT_EQ(single_thread.get(), multi_thread.get());
+    ASSERT_GE(num_progress_calls, 1);
+}
+
+TEST(MosaicAugmentation, FixpointExploresOnlyFrontier) {
+    PatternToAlgMap map;
+    map.insert("GGGGGGGGG", "");
+    const std::vector<std::string> algs = {"F2 B2", "R2 L2 U2 D2"};
+    for (const auto& alg : algs) {
+        CubeState<sides333> cube;
+        cube.applyScramble(alg);
+        map.insert(cube.frontSideStickers(), alg);
+    }
+    const MosaicAugmenter augmenter({"R2 L2", "F B'"});
+    std::vector<AugmentationRound> rounds;
+    const auto result = augment_until_fixpoint(map, augmenter, {}, 3, [](auto&&...) {},
+        [&](const PatternToAlgMap& augmented_map, const AugmentationRound& round) {
+            ASSERT_EQ(augmented_map.size(), round.map_size);
+            rounds.push_back(round);
+        });
+    ASSERT_FALSE(rounds.empty());
+    ASSERT_LE(rounds.size(), 3);
+    ASSERT_EQ(rounds.front().num_algs_explored, map.size());
+    for (size_t i = 1; i < rounds.size(); ++i) {
+        ASSERT_EQ(rounds[i].round, i + 1);
+        ASSERT_EQ(rounds[i].num_algs_explored, rounds[i - 1].num_new_patterns + rounds[i - 1].num_improved_algs);
+    }
+    ASSERT_EQ(result.size(), rounds.back().map_size);
+
+    // first round alone is the same as exploring all algs once
+    std::vector<std::string> all_algs;
+    for (const auto& [pattern, alg] : map.get()) {
+        all_algs.push_back(alg);
+    }
+    const auto single_round = augment_until_fixpoint(map, augmenter, {}, 1, [](auto&&...) {}, [](auto&&...) {});
+    ASSERT_EQ(single_round.get(), augment_in_parallel(map, all_algs, augmenter, {}, [](auto&&...) {}).get());
+    for (const auto& [pattern, alg] : result.get()) {
+        CubeState<sides333> cube;
+        cube.applyScramble(alg);
+        ASSERT_EQ(cube.frontSideStickers(), pattern) << alg;
+    }
+}
+
+TEST(MosaicAugmentation, StopsAtMapSize) {
+    PatternToAlgMap map;
+    map.insert("GGGGGGGGG", "");
+    map.insert("BBBBGBBBB", "F2 B2 R2 L2 U2 D2");
+    const MosaicAugmenter augmenter({"R2 L2", "F B'", "U2 D2", "F2 B2"});
+    size_t num_rounds = 0;
+    const auto unlimited = augment_until_fixpoint(map, augmenter, {}, 5, [](auto&&...) {},
+                                                  [&](auto&&...) {++num_rounds;});
+    ASSERT_GT(unlimited.size(), map.size() + 1);
+    ASSERT_GT(num_rounds, 1);
+
+    // stops right after the first round that reaches the size
+    num_rounds = 0;
+    const auto stopped = augment_until_fixpoint(map, augmenter, {.stop_at_map_size = map.size() + 1}, 5,
+                                                [](auto&&...) {}, [&](auto&&...) {++num_rounds;});
+    ASSERT_GE(stopped.size(), map.size() + 1);
+    ASSERT_EQ(num_rounds, 1);
+    // complete maps aren't explored at all
+    num_rounds = 0;
+    ASSERT_EQ(augment_until_fixpoint(map, augmenter, {.stop_at_map_size = map.size()}, 5, [](auto&&...) {},
+                                     [&](auto&&...) {++num_rounds;}).get(), map.get());
+    ASSERT_EQ(num_rounds, 0);
+}
@@ -1,5 +1,10 @@
 #include "gtest/gtest.h"
 #include "cubing/MovesVector.h"
+#include "cubing/CubeState.h"
+#include "cubing/ScrambleProcessing.h"
+#include "cubing/IterativeScramble.h"
+#include "cubing/FacePatternPredicate.h"
+#include "cubing/RandomScramble.h"
 #include <vector>
 #include <string>
 
@@ -46,3 +51,105 @@ TEST(MovesVector, CombineMoves) {
         ASSERT_EQ(v.to_string_combined_moves(), combined) << scramble;
     }
 }
+
+TEST(MovesVector, SymmetryVariantsMatchStringVersions) {
+    const std::vector<std::string> algs = {"R U R'", "R2 L' D F2 R' D' R' L U' D R D B2 R' U D2", "F B' U2 D"};
+    for (const auto& alg : algs) {
+        const auto v = MovesVector<sides333>::from_string(alg);
+        ASSERT_EQ(v.inverted().to_string(), invertScramble(alg));
+        ASSERT_EQ(v.left2right().to_string(), left2right(alg));
+        ASSERT_EQ(v.front2back().to_string(), front2back(alg));
+        ASSERT_EQ(v.left2right().left2right().to_string(), alg);
+        ASSERT_EQ(v.front2back().front2back().to_string(), alg);
+    }
+}
+
+template<QtmMoveSetSize qtmMoveSetSize>
+static void checkMirroredRotations(const std::string& x, const std::string& y, const std::string& z,
+                                   const std::string& y_prime, const std::string& z_prime) {
+    using Vector = MovesVector<qtmMoveSetSize>;
+    using State = CubeState<qtmMoveSetSize>;
+    const auto compile = [](const std::string& alg) {return State::compileAlgorithm(Vector::from_string(alg));};
+    // mirroring through the M plane keeps x, and turns y and z into y' and z'
+    ASSERT_EQ(State::compileAlgorithm(Vector::from_string(x).left2right()), compile(x));
+    ASSERT_EQ(State::compileAlgorithm(Vector::from_string(y).left2right()), compile(y_prime));
+    ASSERT_EQ(State::compileAlgorithm(Vector::from_string(z).left2right()), compile(z_prime));
+    // mirroring through the S plane keeps z
+    ASSERT_EQ(State::compileAlgorithm(Vector::from_string(z).front2back()), compile(z));
+    ASSERT_EQ(State::compileAlgorithm(Vector::from_string(y).front2back()), compile(y_prime));
+
+    for (const auto& alg : {x, y, z}) {
+        auto state = compile(alg);
+        state.applyPermutation(State::compileAlgorithm(Vector::from_string(alg).inverted()));
+        ASSERT_EQ(state, State::identityPermutation()) << alg;
+    }
+}
+
+TEST(MovesVector, SymmetryVariantsOfSlicesAndInnerLayers) {
+    checkMirroredRotations<sidesAndMid333>("R M' L'", "U E' D'", "F S B'", "U' E D", "F' S' B");
+    checkMirroredRotations<allMoves555>("R r M' l' L'", "U u E' d' D'", "F f S b' B'",
+                                        "U' u' E d D", "F' f' S' b B");
+    ASSERT_EQ(MovesVector<allMoves555>::from_string("r M u2 E' f' S2").left2right().to_string(), "l' M u2 E f S2");
+    ASSERT_EQ(MovesVector<allMoves555>::from_string("r M u2 E' f' S2").front2back().to_string(), "r' M' u2 E b S2");
+}
+
+TEST(MovesVector, RotatedToFront) {
+    using Vector = MovesVector<allMoves555>;
+    using State = CubeState<allMoves555>;
+    ASSERT_EQ(Vector::from_string("R U M r").right2front().to_string(), "F U S' f");
+    ASSERT_EQ(Vector::from_string("R U E u").up2front().to_string(), "R F S' f");
+    // the rotation that takes R (U) to F keeps itself
+    const auto y = Vector::from_string("U u E' d' D'"), x = Vector::from_string("R r M' l' L'");
+    ASSERT_EQ(State::compileAlgorithm(y.right2front()), State::compileAlgorithm(y));
+    ASSERT_EQ(State::compileAlgorithm(x.up2front()), State::compileAlgorithm(x));
+
+    // mosaics on R/L and U/D show up on F/B of the rotated moves
+    const auto front_back = FacePatternPredicate<sidesAndMid333>::compile("opposite F B");
+    const auto right_left = FacePatternPredicate<sidesAndMid333>::compile("opposite R L");
+    const auto up_down = FacePatternPredicate<sidesAndMid333>::compile("opposite U D");
+    RandomScramble<sidesAndMid333> random(47);
+    size_t num_hits = 0;
+    for (size_t i = 0; i < 20000; ++i) {
+        const auto moves = random.next(1 + i % 5);
+        CubeState<sidesAndMid333> cube, right, up;
+        cube.applyScramble(moves);
+        right.applyScramble(moves.right2front());
+        up.applyScramble(moves.up2front());
+        ASSERT_EQ(front_back.matches(right), right_left.matches(cube)) << moves.to_string();
+        ASSERT_EQ(front_back.matches(up), up_down.matches(cube)) << moves.to_string();
+        num_hits += right_left.matches(cube) + up_down.matches(cube);
+    }
+    ASSERT_GT(num_hits, 0);
+}
+
+TEST(MovesVector, Canonicalized) {
+    const std::vector<std::pair<std::string, std::string>> algs_and_canonical = {
+        {"R R'", ""},
+        {"R2 R2 U", "U"},
+        {"L R L'", "R"},
+        {"L' R", "R L'"},
+        {"R U U' R", "R2"},
+        {"F R U2 U2 R' B", "F B"},
+        {"M R2 M' L", "R2 L"},
+        {"R U R' U'", "R U R' U'"},
+        {"S F' B S'", "F' B"},
+        {"", ""},
+    };
+    for (const auto& [alg, canonical] : algs_and_canonical) {
+        const auto moves = MovesVector<sidesAndMid333>::from_string(alg);
+        ASSERT_EQ(moves.canonicalized().to_string(), canonical) << alg;
+        CubeState<sidesAndMid333> expected, actual;
+        expected.applyScramble(moves);
+        actual.applyScramble(moves.canonicalized());
+        ASSERT_EQ(actual, expected) << alg;
+    }
+    ASSERT_EQ(MovesVector<allMoves555>::from_string("l R r' L r").canonicalized().to_string(), "R L l");
+}
+
+TEST(MovesVector, CanonicalizedMatchesIterativeScramble) {
+    IterativeScramble<sidesAndMid333> scramble;
+    while (scramble.size() <= 3) {
+        ++scramble;
+        ASSERT_EQ(scramble.get().canonicalized().to_string(), scramble.get().to_string());
+    }
+}
@@ -0,0 +1,70 @@
+#include "gtest/gtest.h"
+#include "cubing/RandomScramble.h"
+#include "cubing/IterativeScramble.h"
+#include <cmath>
+#include <map>
+
+using namespace cubing;
+
+template<QtmMoveSetSize qtmMoveSetSize>
+static bool is_canonical(const MovesVector<qtmMoveSetSize>& moves) {
+    for (size_t i = 0; i + 1 < moves.size(); ++i) {
+        if (CubeTraits<qtmMoveSetSize>::are_parallel_layer_moves(moves[i], moves[i + 1])
+            && moves[i] % qtmMoveSetSize >= moves[i + 1] % qtmMoveSetSize) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST(RandomScramble, NumSequencesMatchesIterativeScramble) {
+    RandomScramble<sidesAndMid333> random(1);
+    IterativeScramble<sidesAndMid333> scramble;
+    std::map<size_t, size_t> num_sequences;
+    for (++scramble; scramble.size() <= 3; ++scramble) {
+        ++num_sequences[scramble.size()];
+    }
+    for (const auto& [length, count] : num_sequences) {
+        ASSERT_NEAR(std::pow(10., random.log10_num_sequences(length)), double(count), 1e-6 * count) << length;
+    }
+    ASSERT_NEAR(random.log10_num_sequences(0), 0., 1e-12);
+}
+
+TEST(RandomScramble, UniformOverCanonicalSequences) {
+    RandomScramble<sides333> random(42);
+    const size_t length = 2;
+    const double num_sequences = std::round(std::pow(10., random.log10_num_sequences(length)));
+    std::map<std::string, size_t> counts;
+    const size_t num_samples = 200'000;
+    for (const auto& moves : random.generate(length, num_samples)) {
+        ASSERT_EQ(moves.size(), length);
+        ASSERT_TRUE(is_canonical(moves)) << moves.to_string();
+        ++counts[moves.to_string()];
+    }
+    ASSERT_EQ(counts.size(), size_t(num_sequences));
+    const double expected = num_samples / num_sequences;
+    for (const auto& [alg, count] : counts) {
+        ASSERT_NEAR(count, expected, 6 * std::sqrt(expected)) << alg;
+    }
+}
+
+TEST(RandomScramble, DeepSequencesAreCanonical) {
+    RandomScramble<allMoves555> random(7);
+    for (int i = 0; i < 1000; ++i) {
+        const auto moves = random.next(200);
+        ASSERT_EQ(moves.size(), 200);
+        ASSERT_TRUE(is_canonical(moves)) << moves.to_string();
+    }
+    ASSERT_TRUE(std::isfinite(random.log10_num_sequences(200)));
+}
+
+TEST(RandomScramble, SameSeedSameStates) {
+    RandomScramble<sidesAndMid333> a(5), b(5);
+    const auto moves = a.generate(20, 10);
+    const auto states = b.generate_states(20, 10);
+    for (size_t i = 0; i < moves.size(); ++i) {
+        CubeState<sidesAndMid333> cube;
+        cube.applyScramble(moves[i]);
+        ASSERT_EQ(cube, states[i]);
+    }
+}
@@ -0,0 +1,59 @@
+#include "gtest/gtest.h"
+#include "cubing/ReachablePatterns.h"
+#include "cubing/FacePatternPredicate.h"
+#include "cubing/RandomScramble.h"
+#include <filesystem>
+#include <fstream>
+
+using namespace cubing;
+
+static std::string temp_path(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+TEST(ReachablePatterns, AllPatternsAreReachable) {
+    // twists can always be fixed by picking other corners, unless all F and B corner stickers are W or Y, and those
+    // states are reachable by rotating the cube
+    const auto reachable = reachable_two_sided_mosaic_patterns();
+    ASSERT_EQ(reachable.count(), NUM_PATTERNS);
+    ASSERT_EQ(reachable.with_center('G').count(), NUM_PATTERNS / 6);
+    ASSERT_TRUE(reachable.with_center('G').contains("WWWWGWWWW"));
+    ASSERT_FALSE(reachable.with_center('G').contains("WWWWWWWWW"));
+}
+
+TEST(ReachablePatterns, ContainsPatternsOfRandomMosaics) {
+    const auto reachable = reachable_two_sided_mosaic_patterns();
+    const auto mosaic = FacePatternPredicate<sidesAndMid333>::compile(TWO_SIDED_MOSAIC_PREDICATE);
+    RandomScramble<sidesAndMid333> random(48);
+    size_t num_hits = 0;
+    for (const auto& cube : random.generate_states(4, 20000)) {
+        if (mosaic.matches(cube)) {
+            ASSERT_TRUE(reachable.contains(mosaic.key(cube))) << cube.toString();
+            ++num_hits;
+        }
+    }
+    ASSERT_GT(num_hits, 0);
+}
+
+TEST(ReachablePatterns, SaveAndLoad) {
+    PatternBitmap bitmap;
+    for (const auto index : {0u, 1u, 63u, 64u, 12345u, uint32_t(NUM_PATTERNS - 1)}) {
+        bitmap.insert(index);
+    }
+    bitmap.insert("GGGGGGGGG");
+    ASSERT_EQ(bitmap.count(), 7);
+    const auto path = temp_path("reachable_patterns_test.bin");
+    ASSERT_TRUE(bitmap.save_to_file(path));
+    ASSERT_EQ(std::filesystem::file_size(path), 4 + 1 + 4 + NUM_PATTERNS / 8);
+    const auto loaded = PatternBitmap::load_from_file(path);
+    ASSERT_EQ(loaded, bitmap);
+    ASSERT_TRUE(loaded.contains("GGGGGGGGG"));
+    ASSERT_FALSE(loaded.contains(2));
+
+    std::filesystem::resize_file(path, 100);
+    ASSERT_THROW(PatternBitmap::load_from_file(path), std::runtime_error);
+    std::ofstream(path) << "not a bitmap";
+    ASSERT_THROW(PatternBitmap::load_from_file(path), std::runtime_error);
+    std::filesystem::remove(path);
+    ASSERT_THROW(PatternBitmap::load_from_file(path), std::runtime_error);
+}
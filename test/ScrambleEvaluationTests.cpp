@@ -0,0 +1,57 @@
+#include "gtest/gtest.h"
+#include "cubing/ScrambleEvaluation.h"
+#include "cubing/CubeState.h"
+#include <sstream>
+
+using namespace cubing;
+
+TEST(ScrambleEvaluation, TsvRecordsInInputOrder) {
+    std::string input;
+    std::vector<std::string> scrambles;
+    for (int i = 0; i < 100; ++i) {
+        scrambles.push_back(i % 2 ? "R U R' U'" : "M2 E2 S2");
+        input += scrambles.back() + (i % 3 ? "\n" : "\r\n");
+    }
+    input += "R Q\n";
+    std::istringstream in(input);
+    std::ostringstream out;
+    const auto num_evaluated = evaluate_scrambles<sidesAndMid333>(in, out, {
+        .fields = {EvaluationField::front, EvaluationField::mosaic}, .num_threads = 3, .lines_per_batch = 7});
+    ASSERT_EQ(num_evaluated, 101);
+
+    std::istringstream records(out.str());
+    std::string record;
+    for (const auto& scramble : scrambles) {
+        ASSERT_TRUE(std::getline(records, record));
+        CubeState<sidesAndMid333> cube;
+        cube.applyScramble(scramble);
+        ASSERT_EQ(record, scramble + "\t" + cube.frontSideStickers() + "\t"
+                          + (cube.doFrontAndBackSidesHaveSamePatternWithOppositeColors() ? "1" : "0"));
+    }
+    ASSERT_TRUE(std::getline(records, record));
+    ASSERT_EQ(record, "R Q\terror: invalid move at 2");
+    ASSERT_FALSE(std::getline(records, record));
+}
+
+TEST(ScrambleEvaluation, BinaryRecordsHaveFixedSize) {
+    std::istringstream in("R U\nnot a scramble\nL'\n");
+    std::ostringstream out;
+    const std::vector<EvaluationField> fields = {EvaluationField::state, EvaluationField::top};
+    evaluate_scrambles<sides333>(in, out, {.fields = fields, .format = EvaluationOutputFormat::binary});
+    const auto record_size = binary_record_size(fields);
+    ASSERT_EQ(record_size, 1 + 49 + 9);
+    const auto output = out.str();
+    ASSERT_EQ(output.size(), 3 * record_size);
+    ASSERT_EQ(output[0], 1);
+    ASSERT_EQ(output[record_size], 0);
+    ASSERT_EQ(output[2 * record_size], 1);
+
+    CubeState<sides333> cube;
+    cube.applyScramble("L'");
+    ASSERT_EQ(output.substr(2 * record_size + 1), cube.toString() + cube.topSideStickers());
+}
+
+TEST(ScrambleEvaluation, FieldNames) {
+    ASSERT_EQ(evaluation_field_from_string("mosaic"), EvaluationField::mosaic);
+    ASSERT_THROW(evaluation_field_from_string("back"), std::runtime_error);
+}
@@ -0,0 +1,70 @@
+#include "gtest/gtest.h"
+#include "cubing/ScrambleParser.h"
+#include "cubing/CubeState.h"
+#include <string>
+
+using namespace cubing;
+
+TEST(ScrambleParser, SideMoves) {
+    ASSERT_EQ(ScrambleParser<sides333>::parse("R U' F2 L2' D'2 B").to_string(), "R U' F2 L2 D2 B");
+    ASSERT_EQ(ScrambleParser<sides333>::parse("  R\tU'F  ").to_string(), "R U' F");
+    ASSERT_EQ(ScrambleParser<sides333>::parse("").size(), 0);
+    ASSERT_EQ(ScrambleParser<sidesAndMid333>::parse("M E' S2").to_string(), "M E' S2");
+}
+
+TEST(ScrambleParser, WideMovesAndRotations) {
+    ASSERT_EQ(ScrambleParser<sidesAndMid333>::parse("Rw").to_string(), "R M'");
+    ASSERT_EQ(ScrambleParser<sidesAndMid333>::parse("r'").to_string(), "R' M");
+    ASSERT_EQ(ScrambleParser<sidesAndMid333>::parse("x").to_string(), "R M' L'");
+    ASSERT_EQ(ScrambleParser<sidesAndMid333>::parse("y'").to_string(), "U' E D");
+    ASSERT_EQ(ScrambleParser<sidesAndMid333>::parse("z2").to_string(), "F2 S2 B2");
+    ASSERT_EQ(ScrambleParser<sidesAndMid333>::parse("Lw Dw' Bw2").to_string(), "L M D' E' B2 S2");
+    ASSERT_EQ(ScrambleParser<sidesAndMid333>::parse("2R").to_string(), "M'");
+    ASSERT_EQ(ScrambleParser<sidesAndMid333>::parse("3Rw").to_string(), "R M' L'");
+
+    ASSERT_EQ(ScrambleParser<allMoves555>::parse("r").to_string(), "r");
+    ASSERT_EQ(ScrambleParser<allMoves555>::parse("2R").to_string(), "r");
+    ASSERT_EQ(ScrambleParser<allMoves555>::parse("Rw'").to_string(), "R' r'");
+    ASSERT_EQ(ScrambleParser<allMoves555>::parse("3Rw").to_string(), "R r M'");
+    ASSERT_EQ(ScrambleParser<allMoves555>::parse("4Uw2").to_string(), "U2 u2 E2 d2");
+    ASSERT_EQ(ScrambleParser<allMoves555>::parse("x'").to_string(), "R' r' M l L");
+}
+
+TEST(ScrambleParser, Errors) {
+    const auto errorPosition = [](auto parse) -> size_t {
+        try {
+            parse();
+        } catch (const ScrambleParseError& e) {
+            return e.position();
+        }
+        return std::string::npos;
+    };
+    ASSERT_EQ(errorPosition([] {ScrambleParser<sides333>::parse("R U Q");}), 4);
+    ASSERT_EQ(errorPosition([] {ScrambleParser<sides333>::parse("R M");}), 2);
+    ASSERT_EQ(errorPosition([] {ScrambleParser<sides333>::parse("R x");}), 2);
+    ASSERT_EQ(errorPosition([] {ScrambleParser<sides333>::parse("Rw");}), 0);
+    ASSERT_EQ(errorPosition([] {ScrambleParser<sidesAndMid333>::parse("U 4Rw");}), 2);
+    ASSERT_EQ(errorPosition([] {ScrambleParser<sidesAndMid333>::parse("U 3");}), 3);
+    ASSERT_EQ(errorPosition([] {ScrambleParser<allMoves555>::parse("F 2x");}), 2);
+    ASSERT_THROW(MovesVector<sides333>::from_string("R U2 F'?"), std::runtime_error);
+
+    MovesVector<sidesAndMid333> moves;
+    ASSERT_EQ(ScrambleParser<sidesAndMid333>::try_parse("R U M'", moves), std::string::npos);
+    ASSERT_EQ(moves.size(), 3);
+    ASSERT_EQ(ScrambleParser<sidesAndMid333>::try_parse("R Uw'!", moves), 5);
+}
+
+TEST(ScrambleParser, RotationsMatchCube) {
+    using State333 = CubeState<sidesAndMid333>;
+    using State555 = CubeState<allMoves555>;
+    ASSERT_EQ(State333::compileAlgorithm(std::string("x")), State333::compileAlgorithm(std::string("Rw L'")));
+    ASSERT_EQ(State333::compileAlgorithm(std::string("y2")), State333::compileAlgorithm(std::string("Uw2 D2")));
+    ASSERT_EQ(State555::compileAlgorithm(std::string("z'")), State555::compileAlgorithm(std::string("3Fw' b B")));
+    for (const auto& rotation : {"x", "y'", "z"}) {
+        State555 cube;
+        for (int i = 0; i < 4; ++i) {
+            cube.applyScramble(rotation);
+        }
+        ASSERT_TRUE(cube.isSolved()) << rotation;
+    }
+}
@@ -63,4 +63,56 @@ TEST(ScrambleProcessingTests, ExecutionConvenienceScore) {
     ASSERT_GT(execution_convenience_score("Rw' U"), execution_convenience_score("Rw'"));
     ASSERT_GT(execution_convenience_score("Rw' U"), execution_convenience_score("U"));
     ASSERT_GT(execution_convenience_score("S2"), execution_convenience_score("S'"));
-}
\ No newline at end of file
+}
+
+TEST(ScrambleProcessingTests, Normalize) {
+    const std::vector<std::pair<std::string, std::string>> inputs_and_normalized = {
+        {"R U R' U'", "R U R' U'"},
+        {"  R`   U  ", "R' U"},
+        {"R\xE2\x80\x99 U\xCA\xBC F", "R' U' F"},
+        {"(R U R') [x]", "R U R' [x]"},
+        {"\"R, U.\" *F*", "R U F"},
+        {"R'2 U2' F'2'", "R2 U2 F2"},
+        {"U'D' RL Rr Rwr", "U' D' R L R r Rw r"},
+        {"U2D 3RwL U'3Rw", "U2 D 3Rw L U' 3Rw"},
+        {"2Rw 2Lw' 2R", "Rw Lw' 2R"},
+        {"", ""},
+    };
+    for (const auto& [input, normalized] : inputs_and_normalized) {
+        ASSERT_EQ(normalize(input), normalized) << input;
+    }
+}
+
+TEST(ScrambleProcessingTests, ClassifyMoves) {
+    ASSERT_TRUE(isCubeMove("R"));
+    ASSERT_TRUE(isCubeMove("Rw'"));
+    ASSERT_TRUE(isCubeMove("B2"));
+    ASSERT_FALSE(isCubeMove("R2'"));
+    ASSERT_FALSE(isCubeMove("r"));
+    ASSERT_FALSE(isCubeMove("3Rw"));
+    ASSERT_TRUE(isSmallCubeMove("u'"));
+    ASSERT_FALSE(isSmallCubeMove("uw"));
+    ASSERT_TRUE(isSliceCubeMove("M2"));
+    ASSERT_TRUE(isSliceCubeMove("x'"));
+    ASSERT_FALSE(isSliceCubeMove("Mw"));
+    ASSERT_TRUE(is34CubeMove("3Rw"));
+    ASSERT_TRUE(is34CubeMove("4Uw2"));
+    ASSERT_FALSE(is34CubeMove("3R"));
+    ASSERT_FALSE(is34CubeMove("2Rw"));
+    ASSERT_EQ(classifyMove(""), MoveNotation::invalid);
+    ASSERT_EQ(classifyMove("R U"), MoveNotation::invalid);
+}
+
+TEST(ScrambleProcessingTests, TearApartAndGlue333) {
+    ASSERT_EQ(scrambleTearApart333("Rw U x' b2 f'"), "R M' U R' M L B2 S2 F' S'");
+    ASSERT_EQ(scrambleGlueMoves333("R M' U R' M L"), "Rw U x'");
+    ASSERT_EQ(scrambleGlueMoves333(""), "");
+    for (const std::string alg : {"Rw U2 Fw' y", "x2 Dw R' Lw2 z'", "M' U M U2 S"}) {
+        CubeState<sidesAndMid333> expected, torn, glued;
+        expected.applyScramble(alg);
+        torn.applyScramble(scrambleTearApart333(alg));
+        glued.applyScramble(scrambleGlueMoves333(scrambleTearApart333(alg)));
+        ASSERT_EQ(torn, expected) << alg;
+        ASSERT_EQ(glued, expected) << alg;
+    }
+}
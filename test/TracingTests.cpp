@@ -0,0 +1,38 @@
+#include "gtest/gtest.h"
+#include "cubing/Tracing.h"
+#include "cubing/Helpers.h"
+#include <filesystem>
+#include <thread>
+
+using namespace cubing;
+
+TEST(Tracing, WritesSpansOfAllThreads) {
+    ASSERT_FALSE(tracing_enabled()); // unless CUBING_TRACE is set for the tests
+    {
+        CUBING_TRACE_SPAN("not traced");
+    }
+
+    const auto path = (std::filesystem::temp_directory_path() / "cubing_tracing_test.json").string();
+    start_tracing(path);
+    {
+        CUBING_TRACE_SPAN("outer");
+        std::thread([] {
+            set_trace_thread_name("test worker");
+            TraceSpan span(std::string("inner ") + "span");
+        }).join();
+    }
+    stop_tracing();
+    {
+        CUBING_TRACE_SPAN("not traced either");
+    }
+
+    std::string trace;
+    for (const auto& line : getFileContentsAsLines(path)) {
+        trace += line + "\n";
+    }
+    std::filesystem::remove(path);
+    ASSERT_NE(trace.find(R"("name": "outer", "cat": "cubing", "ph": "X")"), std::string::npos) << trace;
+    ASSERT_NE(trace.find(R"("name": "inner span")"), std::string::npos) << trace;
+    ASSERT_NE(trace.find(R"("args": {"name": "test worker"})"), std::string::npos) << trace;
+    ASSERT_EQ(trace.find("not traced"), std::string::npos) << trace;
+}